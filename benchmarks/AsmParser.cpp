@@ -0,0 +1,87 @@
+#include "benchmark/benchmark.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+using namespace llvm;
+
+// The text of a module with many functions of straight-line code and some
+// control flow, of which only one is called from the others.
+static std::string makeModule(unsigned NumFunctions, unsigned NumBlocks) {
+  std::string Str;
+  raw_string_ostream OS(Str);
+  OS << "define i32 @main(i32 %x) {\n  ret i32 %x\n}\n";
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    OS << "define i32 @f" << I << "(i32 %x, i32 %y) {\n"
+       << "entry:\n  %acc0 = add i32 %x, %y\n  br label %b0\n";
+    for (unsigned J = 0; J != NumBlocks; ++J) {
+      OS << "b" << J << ":\n"
+         << "  %c" << J << " = icmp slt i32 %acc" << J << ", %x\n"
+         << "  %t" << J << " = xor i32 %acc" << J << ", %y\n"
+         << "  %m" << J << " = mul i32 %t" << J << ", " << J + 3 << "\n"
+         << "  %s" << J << " = select i1 %c" << J << ", i32 %m" << J
+         << ", i32 %acc" << J << "\n"
+         << "  %acc" << J + 1 << " = call i32 @main(i32 %s" << J << ")\n"
+         << "  br label %b" << J + 1 << "\n";
+    }
+    OS << "b" << NumBlocks << ":\n  ret i32 %acc" << NumBlocks << "\n}\n";
+  }
+  return OS.str();
+}
+
+static void BM_ParseAssembly(benchmark::State &State) {
+  std::string Text = makeModule(State.range(0), 20);
+  for (auto _ : State) {
+    LLVMContext C;
+    SMDiagnostic Err;
+    auto M = parseAssemblyString(Text, Err, C);
+    benchmark::DoNotOptimize(M.get());
+  }
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_ParseAssembly)->Arg(100)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+// Parse the module but only materialize one function, as a tool looking at a
+// few functions of a large module would.
+static void BM_ParseAssemblyLazily(benchmark::State &State) {
+  std::string Text = makeModule(State.range(0), 20);
+  for (auto _ : State) {
+    LLVMContext C;
+    SMDiagnostic Err;
+    auto M = parseAssemblyLazily(MemoryBuffer::getMemBuffer(Text), Err, C);
+    if (Error E = M->getFunction("f0")->materialize())
+      report_fatal_error(std::move(E));
+    benchmark::DoNotOptimize(M.get());
+  }
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_ParseAssemblyLazily)
+    ->Arg(100)
+    ->Arg(2000)
+    ->Unit(benchmark::kMillisecond);
+
+// Parse the module lazily and then materialize all of it, which shows the cost
+// of skipping over the bodies first.
+static void BM_ParseAssemblyLazilyMaterializeAll(benchmark::State &State) {
+  std::string Text = makeModule(State.range(0), 20);
+  for (auto _ : State) {
+    LLVMContext C;
+    SMDiagnostic Err;
+    auto M = parseAssemblyLazily(MemoryBuffer::getMemBuffer(Text), Err, C);
+    if (Error E = M->materializeAll())
+      report_fatal_error(std::move(E));
+    benchmark::DoNotOptimize(M.get());
+  }
+  State.SetBytesProcessed(State.iterations() * Text.size());
+}
+BENCHMARK(BM_ParseAssemblyLazilyMaterializeAll)
+    ->Arg(100)
+    ->Arg(2000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
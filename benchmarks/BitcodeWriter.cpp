@@ -0,0 +1,98 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+using namespace llvm;
+
+// A module with many functions of straight-line code, some control flow and
+// plenty of distinct constants, so that most of the writer's time goes into
+// numbering values.
+static void makeFunctions(Module &M, unsigned NumFunctions,
+                          unsigned NumBlocks) {
+  LLVMContext &C = M.getContext();
+  Type *I32Ty = Type::getInt32Ty(C);
+  Type *Params[] = {I32Ty, I32Ty};
+  FunctionType *FTy = FunctionType::get(I32Ty, Params, false);
+  for (unsigned I = 0; I != NumFunctions; ++I) {
+    Function *F = Function::Create(FTy, Function::ExternalLinkage,
+                                   "f" + std::to_string(I), M);
+    Value *X = &*F->arg_begin();
+    Value *Y = &*std::next(F->arg_begin());
+    BasicBlock *BB = BasicBlock::Create(C, "entry", F);
+    IRBuilder<> B(BB);
+    Value *Acc = B.CreateAdd(X, Y);
+    for (unsigned J = 0; J != NumBlocks; ++J) {
+      BasicBlock *Then = BasicBlock::Create(C, "then", F);
+      BasicBlock *Join = BasicBlock::Create(C, "join", F);
+      B.CreateCondBr(B.CreateICmpSLT(Acc, X), Then, Join);
+      B.SetInsertPoint(Then);
+      Value *T =
+          B.CreateMul(B.CreateXor(Acc, Y), B.getInt32(I * NumBlocks + J));
+      B.CreateBr(Join);
+      B.SetInsertPoint(Join);
+      PHINode *Phi = B.CreatePHI(I32Ty, 2);
+      Phi->addIncoming(Acc, BB);
+      Phi->addIncoming(T, Then);
+      Acc = B.CreateAdd(Phi, B.CreateShl(Y, B.getInt32(J % 8)));
+      BB = Join;
+    }
+    B.CreateRet(Acc);
+  }
+}
+
+static void BM_WriteBitcode(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  makeFunctions(M, State.range(0), 20);
+  SmallVector<char, 0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(M, OS);
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Buffer.size());
+}
+BENCHMARK(BM_WriteBitcode)->Arg(100)->Arg(2000)->Unit(benchmark::kMillisecond);
+
+// The same module with metadata attached to every instruction, like the type
+// based alias analysis and profile metadata of optimized code, so that the
+// writer also spends its time numbering metadata.
+static void BM_WriteBitcodeWithMetadata(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  makeFunctions(M, State.range(0), 20);
+  Type *I32Ty = Type::getInt32Ty(C);
+  unsigned N = 0;
+  for (Function &F : M) {
+    MDNode *Scope = MDNode::get(C, MDString::get(C, F.getName()));
+    for (Instruction &I : instructions(F)) {
+      Metadata *Ops[] = {
+          Scope, ConstantAsMetadata::get(ConstantInt::get(I32Ty, N++ % 512))};
+      I.setMetadata("bench", MDNode::get(C, Ops));
+    }
+  }
+  SmallVector<char, 0> Buffer;
+  for (auto _ : State) {
+    Buffer.clear();
+    raw_svector_ostream OS(Buffer);
+    WriteBitcodeToFile(M, OS);
+    benchmark::DoNotOptimize(Buffer.data());
+  }
+  State.SetBytesProcessed(State.iterations() * Buffer.size());
+}
+BENCHMARK(BM_WriteBitcodeWithMetadata)
+    ->Arg(100)
+    ->Arg(2000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
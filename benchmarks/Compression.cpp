@@ -0,0 +1,102 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/Error.h"
+
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+// Data that compresses about as well as a .debug_str or .debug_info section:
+// many repetitions of a limited set of identifiers, mixed with small numbers.
+static std::string makeDebugData(size_t Size) {
+  static const char *const Words[] = {
+      "llvm",   "detail", "DenseMap", "StringRef", "iterator", "operator",
+      "value",  "const",  "unsigned", "Allocator", "getValue", "std",
+      "vector", "size_t", "basic_string", "char_traits", "SmallVector"};
+  std::mt19937 Rand(0);
+  std::string Data;
+  Data.reserve(Size);
+  while (Data.size() < Size) {
+    Data += Words[Rand() % (sizeof(Words) / sizeof(Words[0]))];
+    Data += Rand() % 4 ? "::" : std::to_string(Rand() % 256);
+    if (Rand() % 8 == 0)
+      Data += '\0';
+  }
+  Data.resize(Size);
+  return Data;
+}
+
+template <typename CompressFn>
+static void benchmarkCompress(benchmark::State &state, CompressFn Compress) {
+  std::string Data = makeDebugData(state.range(0));
+  for (auto _ : state) {
+    SmallVector<char, 0> Compressed;
+    cantFail(Compress(Data, Compressed));
+    benchmark::DoNotOptimize(Compressed.data());
+  }
+  state.SetBytesProcessed(state.iterations() * Data.size());
+}
+
+template <typename CompressFn, typename UncompressFn>
+static void benchmarkUncompress(benchmark::State &state, CompressFn Compress,
+                                UncompressFn Uncompress) {
+  std::string Data = makeDebugData(state.range(0));
+  SmallVector<char, 0> Compressed;
+  cantFail(Compress(Data, Compressed));
+  StringRef CompressedRef(Compressed.data(), Compressed.size());
+  state.counters["ratio"] = double(Data.size()) / Compressed.size();
+  for (auto _ : state) {
+    SmallVector<char, 0> Uncompressed;
+    cantFail(Uncompress(CompressedRef, Uncompressed, Data.size()));
+    benchmark::DoNotOptimize(Uncompressed.data());
+  }
+  state.SetBytesProcessed(state.iterations() * Data.size());
+}
+
+static Error zlibCompress(StringRef Data, SmallVectorImpl<char> &Out) {
+  return zlib::compress(Data, Out);
+}
+static Error zlibUncompress(StringRef Data, SmallVectorImpl<char> &Out,
+                            size_t Size) {
+  return zlib::uncompress(Data, Out, Size);
+}
+static Error zstdCompress(StringRef Data, SmallVectorImpl<char> &Out) {
+  return zstd::compress(Data, Out);
+}
+static Error zstdUncompress(StringRef Data, SmallVectorImpl<char> &Out,
+                            size_t Size) {
+  return zstd::uncompress(Data, Out, Size);
+}
+
+static void BM_ZlibCompress(benchmark::State &state) {
+  if (!zlib::isAvailable())
+    return state.SkipWithError("zlib is not available");
+  benchmarkCompress(state, zlibCompress);
+}
+BENCHMARK(BM_ZlibCompress)->Range(1 << 12, 1 << 24);
+
+static void BM_ZstdCompress(benchmark::State &state) {
+  if (!zstd::isAvailable())
+    return state.SkipWithError("zstd is not available");
+  benchmarkCompress(state, zstdCompress);
+}
+BENCHMARK(BM_ZstdCompress)->Range(1 << 12, 1 << 24);
+
+static void BM_ZlibUncompress(benchmark::State &state) {
+  if (!zlib::isAvailable())
+    return state.SkipWithError("zlib is not available");
+  benchmarkUncompress(state, zlibCompress, zlibUncompress);
+}
+BENCHMARK(BM_ZlibUncompress)->Range(1 << 12, 1 << 24);
+
+static void BM_ZstdUncompress(benchmark::State &state) {
+  if (!zstd::isAvailable())
+    return state.SkipWithError("zstd is not available");
+  benchmarkUncompress(state, zstdCompress, zstdUncompress);
+}
+BENCHMARK(BM_ZstdUncompress)->Range(1 << 12, 1 << 24);
+
+BENCHMARK_MAIN();
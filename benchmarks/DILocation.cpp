@@ -0,0 +1,38 @@
+#include "benchmark/benchmark.h"
+#include "llvm/IR/DIBuilder.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+// Create the locations of a -g module, half of them inlined, and tear the
+// context down again.
+static void BM_CreateDILocations(benchmark::State &State) {
+  unsigned NumLocations = State.range(0);
+  for (auto _ : State) {
+    LLVMContext C;
+    Module M("bench", C);
+    DIBuilder DIB(M);
+    DIFile *File = DIB.createFile("bench.c", "/");
+    DICompileUnit *CU =
+        DIB.createCompileUnit(dwarf::DW_LANG_C, File, "bench", true, "", 0);
+    DISubroutineType *Ty =
+        DIB.createSubroutineType(DIB.getOrCreateTypeArray(None));
+    DISubprogram *SP =
+        DIB.createFunction(CU, "f", "f", File, 1, Ty, 1, DINode::FlagZero,
+                           DISubprogram::SPFlagDefinition);
+    DILocation *InlinedAt = DILocation::getDistinct(C, 1, 1, SP);
+    for (unsigned I = 0; I != NumLocations / 2; ++I) {
+      benchmark::DoNotOptimize(DILocation::get(C, I, I % 80, SP));
+      benchmark::DoNotOptimize(DILocation::get(C, I, I % 80, SP, InlinedAt));
+    }
+  }
+  State.SetItemsProcessed(State.iterations() * NumLocations);
+}
+BENCHMARK(BM_CreateDILocations)
+    ->Arg(1000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
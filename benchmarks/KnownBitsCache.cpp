@@ -0,0 +1,120 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/KnownBitsCache.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/TargetLibraryInfo.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/Transforms/Scalar/InstSimplifyPass.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+// The number of passes that ask the same questions about every instruction,
+// like InstCombine, InstSimplify and CVP do in a pipeline.
+static const unsigned NumPasses = 4;
+
+// A function with a long chain of bit manipulations, where every instruction
+// combines two earlier values, so that the queries recurse to full depth.
+static Function *makeFunction(Module &M, unsigned NumInsts) {
+  LLVMContext &C = M.getContext();
+  Type *I32Ty = Type::getInt32Ty(C);
+  Type *Params[] = {I32Ty, I32Ty};
+  Function *F = Function::Create(FunctionType::get(I32Ty, Params, false),
+                                 Function::ExternalLinkage, "f", M);
+  IRBuilder<> B(BasicBlock::Create(C, "entry", F));
+  std::mt19937 Rand(0);
+  std::vector<Value *> Values = {&*F->arg_begin(), &*std::next(F->arg_begin())};
+  for (unsigned I = 0; I != NumInsts; ++I) {
+    // Mostly combine recent values, to get deep operand chains.
+    size_t Recent = std::min<size_t>(Values.size(), 8);
+    Value *L = Values[Values.size() - 1 - Rand() % Recent];
+    Value *R = Values[Rand() % Values.size()];
+    Value *V;
+    switch (Rand() % 6) {
+    case 0: V = B.CreateAnd(L, B.getInt32(Rand())); break;
+    case 1: V = B.CreateOr(L, R); break;
+    case 2: V = B.CreateXor(L, R); break;
+    case 3: V = B.CreateShl(L, B.getInt32(Rand() % 8)); break;
+    case 4: V = B.CreateLShr(L, B.getInt32(Rand() % 8)); break;
+    default: V = B.CreateAdd(L, R); break;
+    }
+    Values.push_back(V);
+  }
+  B.CreateRet(Values.back());
+  return F;
+}
+
+static void BM_Uncached(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  Function *F = makeFunction(M, State.range(0));
+  const DataLayout &DL = M.getDataLayout();
+  for (auto _ : State)
+    for (unsigned P = 0; P != NumPasses; ++P)
+      for (Instruction &I : instructions(F)) {
+        if (!I.getType()->isIntegerTy())
+          continue;
+        benchmark::DoNotOptimize(computeKnownBits(&I, DL));
+        benchmark::DoNotOptimize(ComputeNumSignBits(&I, DL));
+        benchmark::DoNotOptimize(isKnownNonZero(&I, DL));
+      }
+}
+BENCHMARK(BM_Uncached)->Arg(1000)->Arg(10000);
+
+static void BM_Cached(benchmark::State &State) {
+  LLVMContext C;
+  Module M("bench", C);
+  Function *F = makeFunction(M, State.range(0));
+  for (auto _ : State) {
+    KnownBitsCache KBC(*F);
+    for (unsigned P = 0; P != NumPasses; ++P)
+      for (Instruction &I : instructions(F)) {
+        if (!I.getType()->isIntegerTy())
+          continue;
+        benchmark::DoNotOptimize(KBC.getKnownBits(&I));
+        benchmark::DoNotOptimize(KBC.getNumSignBits(&I));
+        benchmark::DoNotOptimize(KBC.isKnownNonZero(&I));
+      }
+  }
+}
+BENCHMARK(BM_Cached)->Arg(1000)->Arg(10000);
+
+// Run InstSimplify NumPasses times, either computing the known bits in every
+// run or with the known bits cached before the first one.
+static void BM_InstSimplify(benchmark::State &State, bool Cached) {
+  for (auto _ : State) {
+    State.PauseTiming();
+    LLVMContext C;
+    Module M("bench", C);
+    Function *F = makeFunction(M, State.range(0));
+    State.ResumeTiming();
+
+    FunctionAnalysisManager FAM;
+    FAM.registerPass([] { return AssumptionAnalysis(); });
+    FAM.registerPass([] { return DominatorTreeAnalysis(); });
+    FAM.registerPass([] { return KnownBitsAnalysis(); });
+    FAM.registerPass([] { return OptimizationRemarkEmitterAnalysis(); });
+    FAM.registerPass([] { return PassInstrumentationAnalysis(); });
+    FAM.registerPass([] { return TargetLibraryAnalysis(); });
+    FunctionPassManager FPM;
+    if (Cached)
+      FPM.addPass(RequireAnalysisPass<KnownBitsAnalysis, Function>());
+    for (unsigned P = 0; P != NumPasses; ++P)
+      FPM.addPass(InstSimplifyPass());
+    FPM.run(*F, FAM);
+  }
+}
+BENCHMARK_CAPTURE(BM_InstSimplify, Uncached, false)->Arg(1000)->Arg(10000);
+BENCHMARK_CAPTURE(BM_InstSimplify, Cached, true)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
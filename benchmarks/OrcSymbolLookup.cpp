@@ -0,0 +1,48 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ExecutionEngine/Orc/Core.h"
+
+#include <string>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+// Lookups of symbols that are already ready, issued from several threads at
+// once, as done by LLJIT's compile threads when linking against symbols of
+// previously emitted modules.
+static void BM_LookupReadySymbols(benchmark::State &state) {
+  static ExecutionSession *ES;
+  static JITDylib *JD;
+  static std::vector<SymbolStringPtr> Names;
+  constexpr unsigned NumSymbols = 1024;
+
+  if (state.thread_index == 0) {
+    ES = new ExecutionSession();
+    JD = &ES->createJITDylib("main");
+    SymbolMap Symbols;
+    for (unsigned I = 0; I < NumSymbols; ++I) {
+      Names.push_back(ES->intern("sym" + std::to_string(I)));
+      Symbols[Names.back()] =
+          JITEvaluatedSymbol(I + 1, JITSymbolFlags::Exported);
+    }
+    cantFail(JD->define(absoluteSymbols(std::move(Symbols))));
+    for (auto &Name : Names)
+      cantFail(ES->lookup({JD}, Name));
+  }
+
+  unsigned I = state.thread_index;
+  for (auto _ : state) {
+    auto Sym = ES->lookup({JD}, Names[I % NumSymbols]);
+    benchmark::DoNotOptimize(Sym);
+    consumeError(Sym.takeError());
+    I += 7;
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index == 0) {
+    Names.clear();
+    delete ES;
+  }
+}
+BENCHMARK(BM_LookupReadySymbols)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
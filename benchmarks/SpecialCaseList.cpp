@@ -0,0 +1,70 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SpecialCaseList.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+static std::string makeName(std::mt19937 &Rand) {
+  static const char *const Words[] = {"base", "subtle", "internal", "detail",
+                                      "net",  "http",   "cache",    "url",
+                                      "gfx",  "render", "layout",   "dom"};
+  std::string Name = "_ZN";
+  for (unsigned I = 0, E = 2 + Rand() % 3; I != E; ++I) {
+    const char *Word = Words[Rand() % (sizeof(Words) / sizeof(Words[0]))];
+    std::string Id = Word + std::to_string(Rand() % 10000);
+    Name += std::to_string(Id.size()) + Id;
+  }
+  return Name + "Ev";
+}
+
+// An ignore list shaped like the ones of large projects: mostly exact
+// function names and directory or namespace prefixes, some file name suffixes,
+// and a few general wildcard expressions.
+static std::string makeList(unsigned NumEntries) {
+  std::mt19937 Rand(0);
+  std::string List = "[address]\n";
+  for (unsigned I = 0; I != NumEntries; ++I) {
+    std::string Name = makeName(Rand);
+    switch (I % 10) {
+    case 0: case 1: case 2: case 3:
+      List += "fun:" + Name + "\n";
+      break;
+    case 4: case 5: case 6:
+      List += "fun:" + Name.substr(0, Name.size() / 2) + "*\n";
+      break;
+    case 7: case 8:
+      List += "src:*/third_party/" + Name + ".cc\n";
+      break;
+    case 9:
+      List += "fun:*" + Name.substr(3, 12) + "*\n";
+      break;
+    }
+  }
+  return List;
+}
+
+static void BM_SpecialCaseListMatch(benchmark::State &state) {
+  std::string Error;
+  std::unique_ptr<MemoryBuffer> MB =
+      MemoryBuffer::getMemBufferCopy(makeList(state.range(0)));
+  std::unique_ptr<SpecialCaseList> SCL =
+      SpecialCaseList::create(MB.get(), Error);
+
+  std::mt19937 Rand(1);
+  std::vector<std::string> Queries;
+  for (unsigned I = 0; I != 1000; ++I)
+    Queries.push_back(makeName(Rand));
+
+  for (auto _ : state)
+    for (const std::string &Query : Queries)
+      benchmark::DoNotOptimize(SCL->inSection("address", "fun", Query));
+  state.SetItemsProcessed(state.iterations() * Queries.size());
+}
+BENCHMARK(BM_SpecialCaseListMatch)->Arg(1000)->Arg(10000)->Arg(30000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/StringMap.h"
+
+#include <string>
+#include <vector>
+
+using namespace llvm;
+
+// Symbol names of roughly the lengths found in the symbol tables of C++
+// objects, as seen by llvm-nm and llvm-link.
+static std::vector<std::string> makeSymbolNames(unsigned N) {
+  std::vector<std::string> Names;
+  for (unsigned I = 0; I < N; ++I) {
+    std::string Name = "_ZN4llvm" + std::to_string(I * 2654435761u);
+    Name.append(I % 64, 'a' + I % 26);
+    Names.push_back(Name + "Ev");
+  }
+  return Names;
+}
+
+static void BM_StringMapHash(benchmark::State &state) {
+  std::vector<std::string> Names = makeSymbolNames(1024);
+  for (auto _ : state)
+    for (const std::string &Name : Names)
+      benchmark::DoNotOptimize(StringMapImpl::hash(Name));
+  state.SetItemsProcessed(state.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapHash);
+
+static void BM_StringMapInsert(benchmark::State &state) {
+  std::vector<std::string> Names = makeSymbolNames(state.range(0));
+  for (auto _ : state) {
+    StringMap<unsigned> Map;
+    for (unsigned I = 0, E = Names.size(); I != E; ++I)
+      Map.try_emplace(Names[I], I);
+    benchmark::DoNotOptimize(Map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapInsert)->Range(64, 1 << 18);
+
+static void BM_StringMapFind(benchmark::State &state) {
+  std::vector<std::string> Names = makeSymbolNames(state.range(0));
+  StringMap<unsigned> Map;
+  for (unsigned I = 0, E = Names.size(); I != E; ++I)
+    Map.try_emplace(Names[I], I);
+  for (auto _ : state)
+    for (const std::string &Name : Names)
+      benchmark::DoNotOptimize(Map.find(Name));
+  state.SetItemsProcessed(state.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapFind)->Range(64, 1 << 18);
+
+// Looking up every name in two maps, as done when resolving symbols against
+// a module and a global table, with and without reusing the hash.
+static void BM_StringMapFindTwice(benchmark::State &state) {
+  std::vector<std::string> Names = makeSymbolNames(state.range(0));
+  StringMap<unsigned> First, Second;
+  for (unsigned I = 0, E = Names.size(); I != E; ++I) {
+    First.try_emplace(Names[I], I);
+    Second.try_emplace(Names[I], I);
+  }
+  for (auto _ : state) {
+    for (const std::string &Name : Names) {
+      benchmark::DoNotOptimize(First.find(Name));
+      benchmark::DoNotOptimize(Second.find(Name));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapFindTwice)->Range(64, 1 << 18);
+
+static void BM_StringMapFindTwicePrecomputed(benchmark::State &state) {
+  std::vector<std::string> Names = makeSymbolNames(state.range(0));
+  StringMap<unsigned> First, Second;
+  for (unsigned I = 0, E = Names.size(); I != E; ++I) {
+    First.try_emplace(Names[I], I);
+    Second.try_emplace(Names[I], I);
+  }
+  for (auto _ : state) {
+    for (const std::string &Name : Names) {
+      uint32_t Hash = StringMapImpl::hash(Name);
+      benchmark::DoNotOptimize(First.find(Name, Hash));
+      benchmark::DoNotOptimize(Second.find(Name, Hash));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * Names.size());
+}
+BENCHMARK(BM_StringMapFindTwicePrecomputed)->Range(64, 1 << 18);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SwissTableMap.h"
+#include "llvm/Support/Allocator.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+// Pointers to objects of the size of a small IR value, allocated the way
+// LLVMContext allocates them, as used for Value * keyed maps.
+static std::vector<void *> makePointerKeys(unsigned N) {
+  static BumpPtrAllocator Alloc;
+  std::vector<void *> Keys;
+  for (unsigned I = 0; I < N; ++I)
+    Keys.push_back(Alloc.Allocate(48, 8));
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  return Keys;
+}
+
+// Consecutive virtual register numbers, as used for register keyed maps.
+static std::vector<unsigned> makeRegisterKeys(unsigned N) {
+  std::vector<unsigned> Keys;
+  for (unsigned I = 0; I < N; ++I)
+    Keys.push_back((1u << 31) | I);
+  std::shuffle(Keys.begin(), Keys.end(), std::mt19937(0));
+  return Keys;
+}
+
+template <typename MapT, typename KeyT>
+static void benchmarkFind(benchmark::State &state,
+                          const std::vector<KeyT> &Keys) {
+  // Fill the map with half of the keys, so that half of the lookups miss.
+  unsigned N = Keys.size() / 2;
+  MapT Map;
+  for (unsigned I = 0; I < N; ++I)
+    Map[Keys[I]] = I;
+
+  for (auto _ : state) {
+    unsigned Found = 0;
+    for (const KeyT &Key : Keys)
+      Found += Map.count(Key);
+    benchmark::DoNotOptimize(Found);
+  }
+  state.SetItemsProcessed(state.iterations() * Keys.size());
+}
+
+template <typename MapT, typename KeyT>
+static void benchmarkInsert(benchmark::State &state,
+                            const std::vector<KeyT> &Keys) {
+  for (auto _ : state) {
+    MapT Map;
+    for (unsigned I = 0, E = Keys.size(); I != E; ++I)
+      Map[Keys[I]] = I;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_FindPointer(benchmark::State &state) {
+  benchmarkFind<MapT>(state, makePointerKeys(state.range(0)));
+}
+
+template <typename MapT> static void BM_FindRegister(benchmark::State &state) {
+  benchmarkFind<MapT>(state, makeRegisterKeys(state.range(0)));
+}
+
+template <typename MapT> static void BM_InsertPointer(benchmark::State &state) {
+  benchmarkInsert<MapT>(state, makePointerKeys(state.range(0)));
+}
+
+template <typename MapT>
+static void BM_InsertRegister(benchmark::State &state) {
+  benchmarkInsert<MapT>(state, makeRegisterKeys(state.range(0)));
+}
+
+BENCHMARK_TEMPLATE(BM_FindPointer, DenseMap<void *, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindPointer, SwissTableMap<void *, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindRegister, DenseMap<unsigned, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_FindRegister, SwissTableMap<unsigned, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertPointer, DenseMap<void *, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertPointer, SwissTableMap<void *, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertRegister, DenseMap<unsigned, unsigned>)
+    ->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_InsertRegister, SwissTableMap<unsigned, unsigned>)
+    ->Range(16, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,81 @@
+#include "benchmark/benchmark.h"
+#include "llvm/Support/Parallel.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/WorkStealingExecutor.h"
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+using namespace llvm;
+
+// Many tiny tasks submitted from the main thread: measures the cost of the
+// injection queue and of waking workers.
+static void BM_ThreadPoolExternalTasks(benchmark::State &state) {
+  ThreadPool Pool(state.range(0));
+  std::atomic<unsigned> Count{0};
+  for (auto _ : state) {
+    for (unsigned I = 0; I < 10000; ++I)
+      Pool.async([&] { ++Count; });
+    Pool.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+BENCHMARK(BM_ThreadPoolExternalTasks)
+    ->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+// Tasks that fan out into further tasks: these stay on the submitting
+// worker's deque unless another worker steals them.
+static void BM_ThreadPoolRecursiveTasks(benchmark::State &state) {
+  ThreadPool Pool(state.range(0));
+  std::atomic<unsigned> Count{0};
+  for (auto _ : state) {
+    for (unsigned I = 0; I < 100; ++I) {
+      Pool.async([&] {
+        for (unsigned J = 0; J < 100; ++J)
+          Pool.async([&] { ++Count; });
+      });
+    }
+    Pool.wait();
+  }
+  state.SetItemsProcessed(state.iterations() * 10100);
+}
+BENCHMARK(BM_ThreadPoolRecursiveTasks)
+    ->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+#if LLVM_ENABLE_THREADS
+// Nested parallel loops, which used to run serially below the outermost one.
+static void BM_NestedParallelForEach(benchmark::State &state) {
+  // Each outer iteration works on a slice of its own, so the inner loops
+  // don't race.
+  size_t N = state.range(0);
+  std::vector<uint64_t> Data(64 * N);
+  for (auto _ : state) {
+    parallel::for_each_n(parallel::par, size_t(0), size_t(64), [&](size_t I) {
+      uint64_t *Slice = Data.data() + I * N;
+      parallel::for_each_n(parallel::par, size_t(0), N,
+                           [&](size_t J) { Slice[J] += I ^ J; });
+    });
+    benchmark::DoNotOptimize(Data.data());
+  }
+  state.SetItemsProcessed(state.iterations() * 64 * state.range(0));
+}
+BENCHMARK(BM_NestedParallelForEach)->Range(1 << 10, 1 << 16)->UseRealTime();
+
+static void BM_ParallelSort(benchmark::State &state) {
+  std::mt19937 Engine;
+  std::uniform_int_distribution<uint32_t> Dist;
+  std::vector<uint32_t> Data(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (auto &V : Data)
+      V = Dist(Engine);
+    state.ResumeTiming();
+    parallel::sort(parallel::par, Data.begin(), Data.end());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelSort)->Range(1 << 16, 1 << 22)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
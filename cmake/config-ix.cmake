@@ -57,6 +57,7 @@ check_include_file(termios.h HAVE_TERMIOS_H)
 check_include_file(unistd.h HAVE_UNISTD_H)
 check_include_file(valgrind/valgrind.h HAVE_VALGRIND_VALGRIND_H)
 check_include_file(zlib.h HAVE_ZLIB_H)
+check_include_file(zstd.h HAVE_ZSTD_H)
 check_include_file(fenv.h HAVE_FENV_H)
 check_symbol_exists(FE_ALL_EXCEPT "fenv.h" HAVE_DECL_FE_ALL_EXCEPT)
 check_symbol_exists(FE_INEXACT "fenv.h" HAVE_DECL_FE_INEXACT)
@@ -131,6 +132,14 @@ if(NOT LLVM_USE_SANITIZER MATCHES "Memory.*")
     endforeach()
   endif()
 
+  set(HAVE_LIBZSTD 0)
+  if(LLVM_ENABLE_ZSTD)
+    check_library_exists(zstd ZSTD_compress "" HAVE_LIBZSTD_ZSTD)
+    if(HAVE_LIBZSTD_ZSTD)
+      set(HAVE_LIBZSTD 1)
+    endif()
+  endif()
+
   # Don't look for these libraries on Windows.
   if (NOT PURE_WINDOWS)
     # Skip libedit if using ASan as it contains memory leaks.
@@ -523,6 +532,13 @@ if (LLVM_ENABLE_ZLIB )
   endif()
 endif()
 
+if (LLVM_ENABLE_ZSTD )
+  # Check if zstd is available in the system.
+  if ( NOT HAVE_ZSTD_H OR NOT HAVE_LIBZSTD )
+    set(LLVM_ENABLE_ZSTD 0)
+  endif()
+endif()
+
 if (LLVM_ENABLE_DOXYGEN)
   message(STATUS "Doxygen enabled.")
   find_package(Doxygen REQUIRED)
@@ -0,0 +1,622 @@
+//===- llvm/ADT/SwissTableMap.h - Group-probed hash table -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the SwissTableMap class, an open-addressing hash map that
+// keeps one byte of metadata per bucket in a separate control array and probes
+// it a whole group of buckets at a time.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_SWISSTABLEMAP_H
+#define LLVM_ADT_SWISSTABLEMAP_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/EpochTracker.h"
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/MathExtras.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LLVM_SWISSTABLE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define LLVM_SWISSTABLE_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// Values of the control bytes of SwissTableMap. A full bucket stores the low
+/// seven bits of the hash of its key, which are never negative.
+enum : int8_t {
+  SwissCtrlEmpty = -128,
+  SwissCtrlDeleted = -2,
+  SwissCtrlSentinel = -1
+};
+
+/// A group of consecutive control bytes that can be matched at once. Each
+/// match returns a bitmask with bit I set if byte I of the group matched.
+#if defined(LLVM_SWISSTABLE_SSE2)
+class SwissGroup {
+  __m128i Ctrl;
+
+public:
+  static constexpr unsigned Width = 16;
+
+  explicit SwissGroup(const int8_t *Pos)
+      : Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(Pos))) {}
+
+  uint32_t match(int8_t Tag) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(Tag), Ctrl));
+  }
+
+  uint32_t matchEmpty() const { return match(SwissCtrlEmpty); }
+
+  uint32_t matchEmptyOrDeleted() const {
+    return _mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(SwissCtrlSentinel), Ctrl));
+  }
+};
+#elif defined(LLVM_SWISSTABLE_NEON)
+class SwissGroup {
+  int8x16_t Ctrl;
+
+  static uint32_t toBitMask(uint8x16_t Cmp) {
+    static const uint8_t Bits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                     1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t Masked = vandq_u8(Cmp, vld1q_u8(Bits));
+    return vaddv_u8(vget_low_u8(Masked)) |
+           (uint32_t(vaddv_u8(vget_high_u8(Masked))) << 8);
+  }
+
+public:
+  static constexpr unsigned Width = 16;
+
+  explicit SwissGroup(const int8_t *Pos) : Ctrl(vld1q_s8(Pos)) {}
+
+  uint32_t match(int8_t Tag) const {
+    return toBitMask(vceqq_s8(vdupq_n_s8(Tag), Ctrl));
+  }
+
+  uint32_t matchEmpty() const { return match(SwissCtrlEmpty); }
+
+  uint32_t matchEmptyOrDeleted() const {
+    return toBitMask(vcltq_s8(Ctrl, vdupq_n_s8(SwissCtrlSentinel)));
+  }
+};
+#else
+class SwissGroup {
+  int8_t Ctrl[8];
+
+public:
+  static constexpr unsigned Width = 8;
+
+  explicit SwissGroup(const int8_t *Pos) { std::memcpy(Ctrl, Pos, Width); }
+
+  uint32_t match(int8_t Tag) const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Ctrl[I] == Tag) << I;
+    return Mask;
+  }
+
+  uint32_t matchEmpty() const { return match(SwissCtrlEmpty); }
+
+  uint32_t matchEmptyOrDeleted() const {
+    uint32_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint32_t(Ctrl[I] < SwissCtrlSentinel) << I;
+    return Mask;
+  }
+};
+#endif
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT, typename KeyInfoT, bool IsConst>
+class SwissTableMapIterator;
+
+/// An open-addressing hash map with the interface of DenseMap.
+///
+/// DenseMap stores empty and tombstone keys in the buckets themselves, so each
+/// probe step has to load and compare a full key. SwissTableMap keeps a
+/// separate array with one control byte per bucket, holding either seven bits
+/// of the key's hash or an empty/deleted marker. A lookup compares the control
+/// bytes of a whole group of buckets (16 with SSE2 or NEON) in a couple of
+/// instructions and only touches the buckets whose hash bits match, which
+/// usually means a single bucket. It therefore does not need empty or
+/// tombstone keys; only getHashValue() and isEqual() of KeyInfoT are used.
+///
+/// Like DenseMap, elements are stored inline and any insertion may invalidate
+/// iterators and references. The maximum load factor is 7/8.
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class SwissTableMap : public DebugEpochBase {
+  using Group = detail::SwissGroup;
+
+public:
+  using size_type = unsigned;
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = llvm::detail::DenseMapPair<KeyT, ValueT>;
+
+  using iterator = SwissTableMapIterator<KeyT, ValueT, KeyInfoT, false>;
+  using const_iterator = SwissTableMapIterator<KeyT, ValueT, KeyInfoT, true>;
+
+  SwissTableMap() = default;
+
+  /// Create a map that can hold \p InitialReserve elements without growing.
+  explicit SwissTableMap(unsigned InitialReserve) { reserve(InitialReserve); }
+
+  SwissTableMap(std::initializer_list<typename value_type::pair> Vals) {
+    reserve(Vals.size());
+    insert(Vals.begin(), Vals.end());
+  }
+
+  SwissTableMap(const SwissTableMap &Other) : DebugEpochBase() {
+    copyFrom(Other);
+  }
+
+  SwissTableMap(SwissTableMap &&Other) : DebugEpochBase() { swap(Other); }
+
+  ~SwissTableMap() {
+    destroyAll();
+    deallocate();
+  }
+
+  SwissTableMap &operator=(const SwissTableMap &Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocate();
+      copyFrom(Other);
+    }
+    return *this;
+  }
+
+  SwissTableMap &operator=(SwissTableMap &&Other) {
+    destroyAll();
+    deallocate();
+    Ctrl = nullptr;
+    Slots = nullptr;
+    Capacity = Size = GrowthLeft = 0;
+    swap(Other);
+    return *this;
+  }
+
+  void swap(SwissTableMap &Other) {
+    incrementEpoch();
+    Other.incrementEpoch();
+    std::swap(Ctrl, Other.Ctrl);
+    std::swap(Slots, Other.Slots);
+    std::swap(Capacity, Other.Capacity);
+    std::swap(Size, Other.Size);
+    std::swap(GrowthLeft, Other.GrowthLeft);
+  }
+
+  iterator begin() { return iterator(Ctrl, Slots, Slots + Capacity, *this); }
+  iterator end() {
+    return iterator(Ctrl + Capacity, Slots + Capacity, Slots + Capacity,
+                    *this, true);
+  }
+  const_iterator begin() const {
+    return const_iterator(Ctrl, Slots, Slots + Capacity, *this);
+  }
+  const_iterator end() const {
+    return const_iterator(Ctrl + Capacity, Slots + Capacity, Slots + Capacity,
+                          *this, true);
+  }
+
+  LLVM_NODISCARD bool empty() const { return Size == 0; }
+  unsigned size() const { return Size; }
+
+  /// Grow the map so that it can hold \p NumEntries elements without growing
+  /// again.
+  void reserve(size_type NumEntries) {
+    unsigned NewCapacity = getMinCapacityForEntries(NumEntries);
+    if (NewCapacity > Capacity) {
+      incrementEpoch();
+      rehash(NewCapacity);
+    }
+  }
+
+  void clear() {
+    incrementEpoch();
+    if (Size == 0 && GrowthLeft == capacityToGrowth(Capacity))
+      return;
+    destroyAll();
+    if (Capacity)
+      std::memset(Ctrl, detail::SwissCtrlEmpty, Capacity + Group::Width);
+    Size = 0;
+    GrowthLeft = capacityToGrowth(Capacity);
+  }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const KeyT &Key) const {
+    return findSlot(Key, hash(Key)) != Capacity ? 1 : 0;
+  }
+
+  iterator find(const KeyT &Key) {
+    return makeIterator(findSlot(Key, hash(Key)));
+  }
+  const_iterator find(const KeyT &Key) const {
+    return makeConstIterator(findSlot(Key, hash(Key)));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    unsigned I = findSlot(Key, hash(Key));
+    if (I != Capacity)
+      return Slots[I].getSecond();
+    return ValueT();
+  }
+
+  std::pair<iterator, bool> insert(const std::pair<KeyT, ValueT> &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+
+  std::pair<iterator, bool> insert(std::pair<KeyT, ValueT> &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  /// Insert a value constructed from \p Args for \p Key, unless the key is
+  /// already in the map. Returns the element for \p Key, and whether it was
+  /// inserted.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&... Args) {
+    uint64_t H = hash(Key);
+    unsigned I = findSlot(Key, H);
+    if (I != Capacity)
+      return std::make_pair(makeIterator(I), false);
+    I = prepareInsert(H);
+    ::new (&Slots[I]) value_type(std::piecewise_construct,
+                                 std::forward_as_tuple(std::move(Key)),
+                                 std::forward_as_tuple(std::forward<Ts>(Args)...));
+    return std::make_pair(makeIterator(I), true);
+  }
+
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&... Args) {
+    uint64_t H = hash(Key);
+    unsigned I = findSlot(Key, H);
+    if (I != Capacity)
+      return std::make_pair(makeIterator(I), false);
+    I = prepareInsert(H);
+    ::new (&Slots[I]) value_type(std::piecewise_construct,
+                                 std::forward_as_tuple(Key),
+                                 std::forward_as_tuple(std::forward<Ts>(Args)...));
+    return std::make_pair(makeIterator(I), true);
+  }
+
+  ValueT &operator[](const KeyT &Key) {
+    return try_emplace(Key).first->getSecond();
+  }
+
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->getSecond();
+  }
+
+  bool erase(const KeyT &Key) {
+    unsigned I = findSlot(Key, hash(Key));
+    if (I == Capacity)
+      return false;
+    eraseSlot(I);
+    return true;
+  }
+
+  void erase(iterator I) { eraseSlot(I.Ptr - Slots); }
+
+  /// Return the approximate size in bytes of the memory owned by the map.
+  size_t getMemorySize() const {
+    return Capacity ? Capacity * sizeof(value_type) + Capacity + Group::Width
+                    : 0;
+  }
+
+private:
+  /// Mix the bits of the (often weak) DenseMapInfo hash.
+  static uint64_t hash(const KeyT &Key) {
+    return uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+  }
+  /// The bits of the hash that select the first group to probe.
+  static size_t getH1(uint64_t H) { return H ^ (H >> 29); }
+  /// The bits of the hash stored in the control byte of a full bucket.
+  static int8_t getH2(uint64_t H) { return static_cast<int8_t>(H >> 57); }
+
+  static unsigned capacityToGrowth(unsigned Cap) { return Cap - Cap / 8; }
+
+  static unsigned getMinCapacityForEntries(unsigned NumEntries) {
+    if (NumEntries == 0)
+      return 0;
+    unsigned Cap = Group::Width;
+    while (capacityToGrowth(Cap) < NumEntries)
+      Cap *= 2;
+    return Cap;
+  }
+
+  void setCtrl(unsigned I, int8_t Value) {
+    Ctrl[I] = Value;
+    // The first group is mirrored after the last bucket, so that a group can
+    // be loaded starting at any bucket.
+    if (I < Group::Width)
+      Ctrl[Capacity + I] = Value;
+  }
+
+  /// Return the bucket holding \p Key, or Capacity if there is none.
+  unsigned findSlot(const KeyT &Key, uint64_t H) const {
+    if (!Capacity)
+      return 0;
+    int8_t Tag = getH2(H);
+    size_t Mask = Capacity - 1;
+    size_t Pos = getH1(H) & Mask;
+    // Probe groups in triangular steps, which visits every group of a table
+    // whose capacity is a power of two.
+    for (size_t Step = Group::Width;; Step += Group::Width) {
+      Group G(Ctrl + Pos);
+      for (uint32_t Match = G.match(Tag); Match; Match &= Match - 1) {
+        size_t I = (Pos + countTrailingZeros(Match)) & Mask;
+        if (KeyInfoT::isEqual(Key, Slots[I].getFirst()))
+          return I;
+      }
+      if (G.matchEmpty())
+        return Capacity;
+      Pos = (Pos + Step) & Mask;
+    }
+  }
+
+  /// Return the first empty or deleted bucket on the probe sequence of \p H.
+  unsigned findFirstNonFull(uint64_t H) const {
+    size_t Mask = Capacity - 1;
+    size_t Pos = getH1(H) & Mask;
+    for (size_t Step = Group::Width;; Step += Group::Width) {
+      if (uint32_t Match = Group(Ctrl + Pos).matchEmptyOrDeleted())
+        return (Pos + countTrailingZeros(Match)) & Mask;
+      Pos = (Pos + Step) & Mask;
+    }
+  }
+
+  /// Claim a bucket for a new key with hash \p H, growing the table if needed.
+  unsigned prepareInsert(uint64_t H) {
+    incrementEpoch();
+    unsigned I = Capacity ? findFirstNonFull(H) : 0;
+    // Reusing a deleted bucket does not consume any growth.
+    if (!Capacity || (GrowthLeft == 0 && Ctrl[I] != detail::SwissCtrlDeleted)) {
+      grow();
+      I = findFirstNonFull(H);
+    }
+    if (Ctrl[I] == detail::SwissCtrlEmpty)
+      --GrowthLeft;
+    setCtrl(I, getH2(H));
+    ++Size;
+    return I;
+  }
+
+  void eraseSlot(unsigned I) {
+    incrementEpoch();
+    Slots[I].~value_type();
+    --Size;
+
+    // If no window of Group::Width buckets containing I was ever full, a
+    // lookup can never have probed past I, so the bucket can become empty
+    // again instead of deleted.
+    size_t Mask = Capacity - 1;
+    uint32_t EmptyBefore =
+        Group(Ctrl + ((I - Group::Width) & Mask)).matchEmpty();
+    uint32_t EmptyAfter = Group(Ctrl + I).matchEmpty();
+    if (EmptyBefore && EmptyAfter &&
+        countLeadingZeros(EmptyBefore) - (32 - Group::Width) +
+                countTrailingZeros(EmptyAfter) <
+            Group::Width) {
+      setCtrl(I, detail::SwissCtrlEmpty);
+      ++GrowthLeft;
+      return;
+    }
+    setCtrl(I, detail::SwissCtrlDeleted);
+  }
+
+  void grow() {
+    if (!Capacity) {
+      rehash(Group::Width);
+      return;
+    }
+    // Double the capacity, unless deleted buckets take up a large part of the
+    // table, in which case rehashing at the same size reclaims them.
+    if (Size * 32 > capacityToGrowth(Capacity) * 25)
+      rehash(Capacity * 2);
+    else
+      rehash(Capacity);
+  }
+
+  void allocate(unsigned NewCapacity) {
+    Capacity = NewCapacity;
+    Ctrl = static_cast<int8_t *>(
+        allocate_buffer(Capacity + Group::Width, alignof(int8_t)));
+    Slots = static_cast<value_type *>(
+        allocate_buffer(sizeof(value_type) * Capacity, alignof(value_type)));
+  }
+
+  void deallocate() {
+    if (!Capacity)
+      return;
+    deallocate_buffer(Ctrl, Capacity + Group::Width, alignof(int8_t));
+    deallocate_buffer(Slots, sizeof(value_type) * Capacity,
+                      alignof(value_type));
+  }
+
+  void rehash(unsigned NewCapacity) {
+    assert(isPowerOf2_32(NewCapacity) && NewCapacity >= Group::Width &&
+           capacityToGrowth(NewCapacity) >= Size && "Invalid capacity");
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldSlots = Slots;
+    unsigned OldCapacity = Capacity;
+
+    allocate(NewCapacity);
+    std::memset(Ctrl, detail::SwissCtrlEmpty, Capacity + Group::Width);
+    GrowthLeft = capacityToGrowth(Capacity) - Size;
+
+    for (unsigned I = 0; I != OldCapacity; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      uint64_t H = hash(OldSlots[I].getFirst());
+      unsigned NewI = findFirstNonFull(H);
+      setCtrl(NewI, getH2(H));
+      ::new (&Slots[NewI]) value_type(std::move(OldSlots[I]));
+      OldSlots[I].~value_type();
+    }
+
+    if (OldCapacity) {
+      deallocate_buffer(OldCtrl, OldCapacity + Group::Width, alignof(int8_t));
+      deallocate_buffer(OldSlots, sizeof(value_type) * OldCapacity,
+                        alignof(value_type));
+    }
+  }
+
+  void destroyAll() {
+    if (std::is_trivially_destructible<value_type>::value)
+      return;
+    for (unsigned I = 0; I != Capacity; ++I)
+      if (Ctrl[I] >= 0)
+        Slots[I].~value_type();
+  }
+
+  void copyFrom(const SwissTableMap &Other) {
+    Ctrl = nullptr;
+    Slots = nullptr;
+    Capacity = Size = GrowthLeft = 0;
+    if (!Other.Capacity)
+      return;
+    allocate(Other.Capacity);
+    // Keep the exact layout, which avoids rehashing every key.
+    std::memcpy(Ctrl, Other.Ctrl, Capacity + Group::Width);
+    for (unsigned I = 0; I != Capacity; ++I)
+      if (Ctrl[I] >= 0)
+        ::new (&Slots[I]) value_type(Other.Slots[I]);
+    Size = Other.Size;
+    GrowthLeft = Other.GrowthLeft;
+  }
+
+  iterator makeIterator(unsigned I) {
+    return iterator(Ctrl + I, Slots + I, Slots + Capacity, *this, true);
+  }
+  const_iterator makeConstIterator(unsigned I) const {
+    return const_iterator(Ctrl + I, Slots + I, Slots + Capacity, *this, true);
+  }
+
+  int8_t *Ctrl = nullptr;
+  value_type *Slots = nullptr;
+  unsigned Capacity = 0;
+  unsigned Size = 0;
+  /// The number of empty buckets that may still be filled before the table
+  /// has to grow.
+  unsigned GrowthLeft = 0;
+};
+
+template <typename KeyT, typename ValueT, typename KeyInfoT, bool IsConst>
+class SwissTableMapIterator : DebugEpochBase::HandleBase {
+  friend class SwissTableMapIterator<KeyT, ValueT, KeyInfoT, true>;
+  friend class SwissTableMapIterator<KeyT, ValueT, KeyInfoT, false>;
+  friend class SwissTableMap<KeyT, ValueT, KeyInfoT>;
+
+  using Bucket = llvm::detail::DenseMapPair<KeyT, ValueT>;
+  using ConstIterator = SwissTableMapIterator<KeyT, ValueT, KeyInfoT, true>;
+
+public:
+  using difference_type = ptrdiff_t;
+  using value_type =
+      typename std::conditional<IsConst, const Bucket, Bucket>::type;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using iterator_category = std::forward_iterator_tag;
+
+private:
+  const int8_t *Ctrl = nullptr;
+  pointer Ptr = nullptr;
+  pointer End = nullptr;
+
+public:
+  SwissTableMapIterator() = default;
+
+  SwissTableMapIterator(const int8_t *Ctrl, pointer Pos, pointer E,
+                        const DebugEpochBase &Epoch, bool NoAdvance = false)
+      : DebugEpochBase::HandleBase(&Epoch), Ctrl(Ctrl), Ptr(Pos), End(E) {
+    assert(isHandleInSync() && "invalid construction!");
+    if (!NoAdvance)
+      advancePastEmptyBuckets();
+  }
+
+  // Converting ctor from non-const iterators to const iterators. SFINAE'd out
+  // for const iterator destinations so it doesn't end up as a user defined copy
+  // constructor.
+  template <bool IsConstSrc,
+            typename = typename std::enable_if<!IsConstSrc && IsConst>::type>
+  SwissTableMapIterator(
+      const SwissTableMapIterator<KeyT, ValueT, KeyInfoT, IsConstSrc> &I)
+      : DebugEpochBase::HandleBase(I), Ctrl(I.Ctrl), Ptr(I.Ptr), End(I.End) {}
+
+  reference operator*() const {
+    assert(isHandleInSync() && "invalid iterator access!");
+    return *Ptr;
+  }
+  pointer operator->() const {
+    assert(isHandleInSync() && "invalid iterator access!");
+    return Ptr;
+  }
+
+  bool operator==(const ConstIterator &RHS) const {
+    assert((!Ptr || isHandleInSync()) && "handle not in sync!");
+    assert((!RHS.Ptr || RHS.isHandleInSync()) && "handle not in sync!");
+    assert(getEpochAddress() == RHS.getEpochAddress() &&
+           "comparing incomparable iterators!");
+    return Ptr == RHS.Ptr;
+  }
+  bool operator!=(const ConstIterator &RHS) const { return !(*this == RHS); }
+
+  SwissTableMapIterator &operator++() { // Preincrement
+    assert(isHandleInSync() && "invalid iterator access!");
+    ++Ctrl;
+    ++Ptr;
+    advancePastEmptyBuckets();
+    return *this;
+  }
+  SwissTableMapIterator operator++(int) { // Postincrement
+    assert(isHandleInSync() && "invalid iterator access!");
+    SwissTableMapIterator Tmp = *this;
+    ++*this;
+    return Tmp;
+  }
+
+private:
+  void advancePastEmptyBuckets() {
+    assert(Ptr <= End);
+    while (Ptr != End && *Ctrl < 0) {
+      ++Ctrl;
+      ++Ptr;
+    }
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_SWISSTABLEMAP_H
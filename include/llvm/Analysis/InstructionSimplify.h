@@ -45,6 +45,7 @@ class CallBase;
 class DominatorTree;
 class DataLayout;
 class FastMathFlags;
+class KnownBitsCache;
 struct LoopStandardAnalysisResults;
 class OptimizationRemarkEmitter;
 class Pass;
@@ -94,6 +95,10 @@ struct SimplifyQuery {
   AssumptionCache *AC = nullptr;
   const Instruction *CxtI = nullptr;
 
+  /// If set, the known bits of an instruction at its own definition are
+  /// looked up here rather than computed again.
+  KnownBitsCache *KBC = nullptr;
+
   // Wrapper to query additional information for instructions like metadata or
   // keywords like nsw, which provides conservative results if those cannot
   // be safely used.
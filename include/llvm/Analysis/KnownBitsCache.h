@@ -0,0 +1,158 @@
+//===- KnownBitsCache.h - Cached known bits of values -----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the KnownBitsCache class, and associated passes, which
+// memoize the results of computeKnownBits, ComputeNumSignBits, isKnownNonZero
+// and the constant ranges derived from them for the instructions and
+// arguments of a function, so that passes asking the same questions
+// repeatedly don't have to redo the recursive queries every time.
+//
+// This information is computed lazily and cached. Deleting or replacing a
+// cached value also drops the information about its users. Replacing a value
+// that isn't cached itself keeps the information about its users, which stays
+// correct, as replacing doesn't change what the users compute, but may be less
+// precise than recomputing it. If an instruction is modified in place, e.g. by
+// changing its operands or flags, KnownBitsCache has to be notified by calling
+// invalidateValue.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ANALYSIS_KNOWNBITSCACHE_H
+#define LLVM_ANALYSIS_KNOWNBITSCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Optional.h"
+#include "llvm/IR/ConstantRange.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IR/ValueHandle.h"
+#include "llvm/Support/KnownBits.h"
+
+namespace llvm {
+
+class AssumptionCache;
+class DataLayout;
+class DominatorTree;
+class Function;
+class Value;
+
+/// Class for computing and caching the known bits of the values of a
+/// function.
+///
+/// The queries are answered as ValueTracking answers them for the value at its
+/// definition, i.e. with the value itself as the context instruction. Constants
+/// and other values that aren't instructions or arguments are not cached.
+///
+/// Initially the cache is empty, and gets incrementally populated whenever it
+/// is queried.
+class KnownBitsCache {
+public:
+  /// Construct an empty KnownBitsCache.
+  KnownBitsCache(const Function &F, AssumptionCache *AC = nullptr,
+                 const DominatorTree *DT = nullptr);
+
+  /// Return the known bits of \p V, which must be of integer, pointer or
+  /// integer vector type.
+  KnownBits getKnownBits(const Value *V);
+
+  /// Return the number of bits of \p V known to be equal to its sign bit. \p V
+  /// must be of integer or integer vector type.
+  unsigned getNumSignBits(const Value *V);
+
+  /// Return true if \p V is known to be non-zero.
+  bool isKnownNonZero(const Value *V);
+
+  /// Return the range of \p V, which must be of integer or integer vector
+  /// type, as unsigned or signed range as requested by \p IsSigned. This is
+  /// the range implied by its known bits intersected with the one from
+  /// computeConstantRange.
+  ConstantRange getConstantRange(const Value *V, bool IsSigned);
+
+  /// Notify KnownBitsCache that the cached information about V is no longer
+  /// valid.
+  ///
+  /// Whenever an instruction is modified in place, the cached information for
+  /// it, and for the values computed from it, becomes invalid. This clears
+  /// the information about V and about its users, up to the depth that the
+  /// queries look through.
+  void invalidateValue(const Value *V);
+
+  /// Free the memory used by this class.
+  void releaseMemory();
+
+  /// Print out the information currently in the cache, for the instructions
+  /// and arguments of the function.
+  void print(raw_ostream &OS) const;
+
+  /// Handle invalidation events in the new pass manager.
+  bool invalidate(Function &F, const PreservedAnalyses &PA,
+                  FunctionAnalysisManager::Invalidator &Inv);
+
+private:
+  /// The information cached about a value. Each query fills in its part.
+  struct CachedInfo {
+    Optional<KnownBits> Known;
+    unsigned NumSignBits = 0;
+    Optional<bool> NonZero;
+    Optional<ConstantRange> UnsignedRange;
+    Optional<ConstantRange> SignedRange;
+  };
+
+  /// A CallbackVH to notify KnownBitsCache when a value is deleted or
+  /// replaced, so that the cached information for that value and its users
+  /// can be cleared.
+  class KnownBitsCallbackVH final : public CallbackVH {
+    KnownBitsCache *KBC;
+    void deleted() override;
+    void allUsesReplacedWith(Value *New) override;
+
+  public:
+    KnownBitsCallbackVH(Value *V, KnownBitsCache *KBC = nullptr)
+        : CallbackVH(V), KBC(KBC) {}
+  };
+
+  /// Return the cache entry for \p V, or null if \p V isn't cached.
+  CachedInfo *getCachedInfo(const Value *V);
+
+  DenseMap<KnownBitsCallbackVH, CachedInfo, DenseMapInfo<Value *>> Cache;
+
+  /// The function that the KnownBitsCache is for.
+  const Function &F;
+  const DataLayout &DL;
+  AssumptionCache *AC;
+  const DominatorTree *DT;
+};
+
+/// The analysis pass which yields a KnownBitsCache
+///
+/// The analysis does nothing by itself, and just returns an empty
+/// KnownBitsCache which will get filled in as it's used.
+class KnownBitsAnalysis : public AnalysisInfoMixin<KnownBitsAnalysis> {
+  friend AnalysisInfoMixin<KnownBitsAnalysis>;
+  static AnalysisKey Key;
+
+public:
+  using Result = KnownBitsCache;
+  KnownBitsCache run(Function &F, FunctionAnalysisManager &AM);
+};
+
+/// A pass for printing the KnownBitsCache for a function.
+///
+/// This pass first queries the KnownBitsCache for all the integer and pointer
+/// instructions and arguments in the function, so the complete information is
+/// printed.
+class KnownBitsPrinterPass : public PassInfoMixin<KnownBitsPrinterPass> {
+  raw_ostream &OS;
+
+public:
+  explicit KnownBitsPrinterPass(raw_ostream &OS) : OS(OS) {}
+  PreservedAnalyses run(Function &F, FunctionAnalysisManager &AM);
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ANALYSIS_KNOWNBITSCACHE_H
@@ -43,6 +43,11 @@ class StringRef;
 class TargetLibraryInfo;
 class Value;
 
+  /// The maximal depth of the operand graph that the recursive queries below,
+  /// such as computeKnownBits, ComputeNumSignBits and isKnownNonZero, look
+  /// through.
+  constexpr unsigned MaxAnalysisRecursionDepth = 6;
+
   /// Determine which bits of V are known to be either zero or one and return
   /// them in the KnownZero/KnownOne bit sets.
   ///
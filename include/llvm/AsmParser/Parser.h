@@ -67,6 +67,22 @@ std::unique_ptr<Module> parseAssemblyString(StringRef AsmString,
                                             bool UpgradeDebugInfo = true,
                                             StringRef DataLayoutString = "");
 
+/// Parse LLVM Assembly from a MemoryBuffer, skipping over the function bodies.
+/// The functions with a body are materializable, and their bodies are parsed
+/// when they're materialized, or when the module is, so only the functions
+/// that are needed have to be parsed. Errors in the bodies are reported then.
+/// The module owns the buffer.
+/// \param Buffer The MemoryBuffer containing assembly
+/// \param Err Error result info.
+/// \param Context Context in which to allocate globals info.
+/// \param UpgradeDebugInfo Run UpgradeDebugInfo when the module is
+///                         materialized.
+/// \param DataLayoutString Override datalayout in the llvm assembly.
+std::unique_ptr<Module>
+parseAssemblyLazily(std::unique_ptr<MemoryBuffer> Buffer, SMDiagnostic &Err,
+                    LLVMContext &Context, bool UpgradeDebugInfo = true,
+                    StringRef DataLayoutString = "");
+
 /// Holds the Module and ModuleSummaryIndex returned by the interfaces
 /// that parse both.
 struct ParsedModuleAndIndex {
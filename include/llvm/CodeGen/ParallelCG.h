@@ -35,6 +35,15 @@ class raw_pwrite_stream;
 /// BCOSs is not empty.
 ///
 /// \returns M if OSs.size() == 1, otherwise returns std::unique_ptr<Module>().
+///
+/// FIXME: Partitions are code generated in separate LLVMContexts because the
+/// codegen pipeline cannot run on several functions of one module at once.
+/// IR-level passes such as CodeGenPrepare create constants and types in the
+/// shared LLVMContext, machine passes allocate MCSymbols through the shared
+/// MCContext and MachineModuleInfo, and AsmPrinter streams each function as
+/// soon as it is done. Running MachineFunction passes concurrently would
+/// require synchronizing or sharding those first, and buffering per-function
+/// output so that it can be emitted in module order.
 std::unique_ptr<Module>
 splitCodeGen(std::unique_ptr<Module> M, ArrayRef<raw_pwrite_stream *> OSs,
              ArrayRef<llvm::raw_pwrite_stream *> BCOSs,
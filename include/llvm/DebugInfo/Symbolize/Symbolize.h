@@ -13,12 +13,18 @@
 #ifndef LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 #define LLVM_DEBUGINFO_SYMBOLIZE_SYMBOLIZE_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/ilist_node.h"
+#include "llvm/ADT/simple_ilist.h"
 #include "llvm/DebugInfo/Symbolize/SymbolizableModule.h"
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Error.h"
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -44,6 +50,10 @@ public:
     std::vector<std::string> DsymHints;
     std::string FallbackDebugPath;
     std::string DWPName;
+    /// Total file size in bytes of the binaries that pruneCache() keeps open,
+    /// or 0 to keep every binary open until flush(). Memory used by the debug
+    /// info parsed from them is not counted.
+    size_t MaxCacheSize = 0;
   };
 
   LLVMSymbolizer() = default;
@@ -60,6 +70,14 @@ public:
   Expected<DIInliningInfo>
   symbolizeInlinedCode(const std::string &ModuleName,
                        object::SectionedAddress ModuleOffset);
+  /// Symbolize all of \p ModuleOffsets in \p ModuleName with a single module
+  /// lookup. The offsets are processed in address order, so that consecutive
+  /// queries hit the same compile unit and line table, and each distinct
+  /// offset is symbolized only once. The results are returned in the order of
+  /// \p ModuleOffsets.
+  Expected<std::vector<DIInliningInfo>>
+  symbolizeInlinedCode(const std::string &ModuleName,
+                       ArrayRef<object::SectionedAddress> ModuleOffsets);
   Expected<DIGlobal> symbolizeData(const std::string &ModuleName,
                                    object::SectionedAddress ModuleOffset);
   Expected<std::vector<DILocal>>
@@ -67,6 +85,12 @@ public:
                  object::SectionedAddress ModuleOffset);
   void flush();
 
+  /// Evict the least recently used binaries, together with the modules and
+  /// object files loaded from them, until the total size of the open binaries
+  /// is within Options::MaxCacheSize. Any SymbolizableModule or ObjectFile
+  /// previously handed out may be invalidated.
+  void pruneCache();
+
   static std::string
   DemangleName(const std::string &Name,
                const SymbolizableModule *DbiModuleDescriptor);
@@ -76,6 +100,33 @@ private:
   // corresponding debug info. These objects can be the same.
   using ObjectPair = std::pair<const ObjectFile *, const ObjectFile *>;
 
+  /// An open binary, linked into the LRU list once it was parsed
+  /// successfully. Everything derived from the binary registers an evictor
+  /// that drops it when the binary is evicted.
+  class CachedBinary : public ilist_node<CachedBinary> {
+  public:
+    OwningBinary<Binary> Bin;
+
+    /// Add an action to run when the binary is evicted. Evictors run in
+    /// reverse order of registration.
+    void pushEvictor(unsigned Key, std::function<void()> NewEvictor) {
+      Evictors.emplace_back(Key, std::move(NewEvictor));
+    }
+
+    /// Remove the evictor registered under \p Key, if any.
+    void eraseEvictor(unsigned Key) {
+      llvm::erase_if(Evictors,
+                     [&](const auto &Evictor) { return Evictor.first == Key; });
+    }
+
+    void evict();
+
+    size_t size() const { return Bin.getBinary()->getData().size(); }
+
+  private:
+    SmallVector<std::pair<unsigned, std::function<void()>>, 2> Evictors;
+  };
+
   Expected<DILineInfo>
   symbolizeCodeCommon(SymbolizableModule *Info,
                       object::SectionedAddress ModuleOffset);
@@ -109,14 +160,38 @@ private:
   Expected<ObjectFile *> getOrCreateObject(const std::string &Path,
                                           const std::string &ArchName);
 
+  /// Return the cached binary \p Obj was loaded from, or null if \p Obj is
+  /// not owned by the cache.
+  CachedBinary *getCachedBinaryFor(const ObjectFile *Obj);
+
+  /// Mark \p Bin as the most recently used binary.
+  void recordAccess(CachedBinary &Bin);
+
+  /// Run \p Evictor when the first of \p Bins is evicted. It is removed
+  /// from the other binaries then, so they don't collect stale evictors when
+  /// what it dropped is created again.
+  void addEvictor(ArrayRef<CachedBinary *> Bins, std::function<void()> Evictor);
+
   std::map<std::string, std::unique_ptr<SymbolizableModule>> Modules;
 
+  /// The binaries each entry of Modules was loaded from.
+  std::map<std::string, SmallVector<CachedBinary *, 2>> ModuleBinaries;
+
   /// Contains cached results of getOrCreateObjectPair().
   std::map<std::pair<std::string, std::string>, ObjectPair>
       ObjectPairForPathArch;
 
   /// Contains parsed binary for each path, or parsing error.
-  std::map<std::string, OwningBinary<Binary>> BinaryForPath;
+  std::map<std::string, CachedBinary> BinaryForPath;
+
+  /// Successfully parsed binaries, least recently used first.
+  simple_ilist<CachedBinary> LRUBinaries;
+
+  /// The key of the next evictor added with addEvictor().
+  unsigned NextEvictorKey = 0;
+
+  /// Sum of the sizes of the binaries in LRUBinaries.
+  size_t CacheSize = 0;
 
   /// Parsed object file for path/architecture pair, where "path" refers
   /// to Mach-O universal binary.
@@ -20,7 +20,9 @@
 #include "llvm/ExecutionEngine/OrcV1Deprecation.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/RWMutex.h"
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -705,8 +707,43 @@ private:
 
   using SymbolTable = DenseMap<SymbolStringPtr, SymbolTableEntry>;
 
+  /// A copy of the Ready entries of the symbol table, split into shards with
+  /// their own reader/writer locks. Ready symbols never change, so lookups of
+  /// them can be answered from here without taking the session lock. It is
+  /// only ever modified with the session lock held.
+  class ReadySymbolTable {
+  public:
+    void add(const SymbolStringPtr &Name, JITEvaluatedSymbol Sym);
+    void remove(const SymbolStringPtr &Name);
+    bool lookup(const SymbolStringPtr &Name, JITEvaluatedSymbol &Sym) const;
+
+  private:
+    struct Shard {
+      mutable sys::SmartRWMutex<true> Mutex;
+      SymbolMap Symbols;
+    };
+
+    static constexpr unsigned NumShards = 16;
+
+    Shard &getShard(const SymbolStringPtr &Name) {
+      return Shards[DenseMapInfo<SymbolStringPtr>::getHashValue(Name) %
+                    NumShards];
+    }
+    const Shard &getShard(const SymbolStringPtr &Name) const {
+      return const_cast<ReadySymbolTable *>(this)->getShard(Name);
+    }
+
+    std::array<Shard, NumShards> Shards;
+  };
+
   JITDylib(ExecutionSession &ES, std::string Name);
 
+  /// Resolve all of \p Names from ReadySymbols into \p Result. Returns false,
+  /// leaving \p Result in an unspecified state, if any of them is not a
+  /// visible Ready symbol of this JITDylib.
+  bool lookupReady(const SymbolNameSet &Names, bool MatchNonExported,
+                   SymbolMap &Result) const;
+
   Error defineImpl(MaterializationUnit &MU);
 
   Expected<SymbolNameSet> lookupFlagsImpl(SymbolFlagsMap &Flags,
@@ -751,6 +788,7 @@ private:
   ExecutionSession &ES;
   std::string JITDylibName;
   SymbolTable Symbols;
+  ReadySymbolTable ReadySymbols;
   UnmaterializedInfosMap UnmaterializedInfos;
   MaterializingInfosMap MaterializingInfos;
   std::vector<std::unique_ptr<DefinitionGenerator>> DefGenerators;
@@ -195,6 +195,7 @@ public:
   Optional<JITTargetMachineBuilder> JTMB;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unsigned NumCompileThreads = 0;
 
   /// Called prior to JIT class construcion to fix up defaults.
@@ -241,6 +242,17 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache to be used by the default compile function, e.g. an
+  /// OnDiskObjectCache to reuse objects across JIT sessions. The cache must
+  /// outlive the JIT instance, and must be thread-safe if compile threads are
+  /// used.
+  ///
+  /// This setting is ignored if a CompileFunctionCreator is set.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set the number of compile threads to use.
   ///
   /// If set to zero, compilation will be performed on the execution thread when
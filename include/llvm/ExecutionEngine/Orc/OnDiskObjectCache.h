@@ -0,0 +1,85 @@
+//===- OnDiskObjectCache.h - Persistent object cache for ORC ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that keeps compiled objects in a directory on disk, so that
+// they can be reused across JIT sessions.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/CachePruning.h"
+#include "llvm/Support/Error.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+class JITTargetMachineBuilder;
+
+/// An ObjectCache that stores objects as files in a cache directory.
+///
+/// Entries are keyed by a SHA1 hash of the module's bitcode together with the
+/// target triple, CPU, features and the code generation options of the
+/// JITTargetMachineBuilder the cache was created for, so a cached object is
+/// only reused for an identical module compiled with an identical
+/// configuration. Files are named like the ThinLTO cache entries and can be
+/// pruned with llvm::pruneCache() according to a CachePruningPolicy; this
+/// includes temporary files left behind by a process that died while writing
+/// an entry.
+///
+/// The cache is thread-safe and may be shared by the compile threads of a
+/// ConcurrentIRCompiler, e.g. via LLJITBuilder::setObjectCache().
+class OnDiskObjectCache : public ObjectCache {
+public:
+  /// Create a cache in \p CacheDir, creating the directory if needed, for
+  /// objects compiled with the target configuration described by \p JTMB.
+  /// The directory is pruned according to \p Policy now and whenever prune()
+  /// is called.
+  static Expected<std::unique_ptr<OnDiskObjectCache>>
+  Create(StringRef CacheDir, const JITTargetMachineBuilder &JTMB,
+         CachePruningPolicy Policy = CachePruningPolicy());
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  void notifyObjectCompileFailed(const Module *M) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+  /// Prune the cache directory according to the pruning policy. Returns true
+  /// if pruning took place.
+  bool prune();
+
+private:
+  OnDiskObjectCache(StringRef CacheDir, std::string ConfigKey,
+                    CachePruningPolicy Policy)
+      : CacheDir(CacheDir), ConfigKey(std::move(ConfigKey)),
+        Policy(std::move(Policy)) {}
+
+  std::string computeKey(const Module &M) const;
+
+  SmallString<128> CacheDir;
+  std::string ConfigKey;
+  CachePruningPolicy Policy;
+
+  /// Keys of the modules that missed in getObject(), computed before code
+  /// generation had a chance to modify them. Each entry is removed again by
+  /// notifyObjectCompiled() or notifyObjectCompileFailed(), so a later module
+  /// allocated at the same address never picks up a stale key.
+  std::mutex PendingKeysMutex;
+  DenseMap<const Module *, std::string> PendingKeys;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
@@ -1360,6 +1360,19 @@ class DILocation : public MDNode {
              unsigned Column, ArrayRef<Metadata *> MDs, bool ImplicitCode);
   ~DILocation() { dropAllReferences(); }
 
+  /// Allocate from the context rather than with malloc, which would add a
+  /// large fraction to nodes this small.
+  void *operator new(size_t Size, unsigned NumOps, LLVMContext &Context);
+  void operator delete(void *) = delete;
+
+  /// Destroy the node and give its storage back to the context.
+  void destroy();
+
+  /// Required by std, but never called.
+  void operator delete(void *, unsigned, LLVMContext &) {
+    llvm_unreachable("Constructor throws?");
+  }
+
   static DILocation *getImpl(LLVMContext &Context, unsigned Line,
                              unsigned Column, Metadata *Scope,
                              Metadata *InlinedAt, bool ImplicitCode,
@@ -42,6 +42,7 @@
 
 namespace llvm {
 
+class DILocation;
 class Module;
 class ModuleSlotTracker;
 class raw_ostream;
@@ -887,6 +888,11 @@ protected:
     llvm_unreachable("Constructor throws?");
   }
 
+  /// Destroy a node of a known subclass and free its storage. DILocations
+  /// are not allocated with operator new, so they have their own overload.
+  template <class NodeTy> static void deleteNode(NodeTy *N) { delete N; }
+  static void deleteNode(DILocation *N);
+
   void dropAllReferences();
 
   MDOperand *mutable_begin() { return mutable_end() - NumOperands; }
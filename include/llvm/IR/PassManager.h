@@ -1279,6 +1279,15 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// The functions are visited one at a time. Running the pipelines of different
+/// functions concurrently would need more than the rules above: even a pass
+/// that only touches its own function creates constants, types and metadata in
+/// the shared LLVMContext, and edits the use lists of the globals and
+/// constants it refers to. None of that is synchronized, and neither are the
+/// AnalysisManager caches and the pass instrumentation callbacks. To optimize
+/// or codegen a module in parallel today, split it into modules with their own
+/// contexts, as ThinLTO backends and splitCodeGen do.
 template <typename FunctionPassT>
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor<FunctionPassT>> {
@@ -117,6 +117,14 @@ struct Config {
   /// Statistics output file path.
   std::string StatsFile;
 
+  /// Whether the ThinLTO backend threads should record time trace events.
+  /// The caller initializes the profiler of the calling thread and writes the
+  /// trace; the events of the backend threads are merged into it.
+  bool TimeTraceEnabled = false;
+
+  /// Minimum duration of a recorded time trace event, in microseconds.
+  unsigned TimeTraceGranularity = 500;
+
   bool ShouldDiscardValueNames = true;
   DiagnosticHandlerFunction DiagHandler;
 
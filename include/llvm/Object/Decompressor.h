@@ -58,6 +58,8 @@ private:
 
   StringRef SectionData;
   uint64_t DecompressedSize;
+  /// The ELF compression type, ELFCOMPRESS_ZLIB or ELFCOMPRESS_ZSTD.
+  uint32_t CompressionType;
 };
 
 } // end namespace object
@@ -57,23 +57,29 @@ public:
       Cond.notify_all();
   }
 
+  bool isDone() const {
+    std::lock_guard<std::mutex> lock(Mutex);
+    return Count == 0;
+  }
+
   void sync() const {
     std::unique_lock<std::mutex> lock(Mutex);
     Cond.wait(lock, [&] { return Count == 0; });
   }
 };
 
+/// A group of tasks run on the default WorkStealingExecutor. Waiting for the
+/// group executes queued tasks on the waiting thread, so task groups can be
+/// nested inside tasks of other task groups without deadlocking.
 class TaskGroup {
   Latch L;
-  bool Parallel;
 
 public:
-  TaskGroup();
   ~TaskGroup();
 
   void spawn(std::function<void()> f);
 
-  void sync() const { L.sync(); }
+  void sync() const;
 };
 
 const ptrdiff_t MinParallelSize = 1024;
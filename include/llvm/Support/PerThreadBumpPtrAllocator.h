@@ -0,0 +1,168 @@
+//===- PerThreadBumpPtrAllocator.h - Per-thread arenas ----------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines PerThreadAllocator, which gives every thread that uses it
+// a private allocator, so that parallel code can bump-allocate without locking
+// and without one arena per task.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
+#define LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Allocator.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+
+namespace detail {
+
+/// The part of PerThreadAllocator that does not depend on the allocator type.
+class PerThreadAllocatorBase {
+protected:
+  PerThreadAllocatorBase();
+  ~PerThreadAllocatorBase() = default;
+
+  /// Return the allocator of the calling thread. \p Create is called, with the
+  /// lock held, to make one the first time a thread asks for it.
+  void *getThreadLocal(function_ref<void *()> Create);
+
+  /// Detach all threads from their allocators, so that each thread calls
+  /// \p Create again on its next use. Must be called with the lock held.
+  void forgetThreads();
+
+  /// Protects the list of allocators in the derived class.
+  mutable std::mutex Lock;
+
+private:
+  /// Identifies the arena in the per-thread cache. Unlike the address of the
+  /// arena, it is never reused. It changes on every forgetThreads().
+  uint64_t ID;
+
+  /// The allocator of every thread that used the arena, by thread number.
+  DenseMap<uint64_t, void *> Threads;
+};
+
+template <typename AllocatorTy> void resetAllocator(AllocatorTy &Alloc) {
+  Alloc.Reset();
+}
+
+template <typename T> void resetAllocator(SpecificBumpPtrAllocator<T> &Alloc) {
+  Alloc.DestroyAll();
+}
+
+} // end namespace detail
+
+/// An arena that hands every thread its own \p AllocatorTy.
+///
+/// Threads allocate from their own allocator without any synchronization, and
+/// each allocator keeps its slabs. getThreadLocalAllocator() returns a
+/// reference to the usual allocator type, so it can back a StringSaver or a
+/// UniqueStringSaver, and with SpecificBumpPtrAllocator as \p AllocatorTy it
+/// interns objects of one type:
+///
+/// \code
+///   PerThreadBumpPtrAllocator Arena;
+///   parallelForEach(Inputs, [&](const Input &I) {
+///     StringSaver Saver(Arena.getThreadLocalAllocator());
+///     ...
+///   });
+/// \endcode
+///
+/// Finding the allocator of the calling thread takes a thread-local lookup,
+/// so tasks should look it up once rather than for every allocation. Each
+/// thread caches its allocators for a few arenas at once; a thread that
+/// alternates between more arenas than that takes an arena's lock on a miss.
+///
+/// Reset() hands the allocators, each still holding its first slab, to
+/// whichever threads use the arena next. The arena therefore holds as many
+/// allocators as the most threads that used it between two resets, not one
+/// for every thread that ever touched it.
+///
+/// Memory stays valid until Reset() or the destruction of the arena. Both, as
+/// well as the statistics, must not race with allocations.
+template <typename AllocatorTy>
+class PerThreadAllocator : public detail::PerThreadAllocatorBase {
+public:
+  PerThreadAllocator() = default;
+  PerThreadAllocator(const PerThreadAllocator &) = delete;
+  PerThreadAllocator &operator=(const PerThreadAllocator &) = delete;
+
+  /// Return the allocator of the calling thread.
+  AllocatorTy &getThreadLocalAllocator() {
+    return *static_cast<AllocatorTy *>(getThreadLocal([this]() -> void * {
+      if (NumInUse == Allocators.size())
+        Allocators.push_back(std::make_unique<AllocatorTy>());
+      return Allocators[NumInUse++].get();
+    }));
+  }
+
+  /// Allocate \p Size bytes from the allocator of the calling thread.
+  void *Allocate(size_t Size, size_t Alignment) {
+    return getThreadLocalAllocator().Allocate(Size, Alignment);
+  }
+
+  /// Allocate space for \p Num objects of type \p T from the allocator of the
+  /// calling thread.
+  template <typename T> T *Allocate(size_t Num = 1) {
+    return getThreadLocalAllocator().template Allocate<T>(Num);
+  }
+
+  /// Free all memory allocated so far. Every allocator keeps its first slab
+  /// and is handed to the next thread that uses the arena, which need not be
+  /// the thread that used it before.
+  void Reset() {
+    std::lock_guard<std::mutex> Guard(Lock);
+    for (auto &Alloc : Allocators)
+      detail::resetAllocator(*Alloc);
+    NumInUse = 0;
+    forgetThreads();
+  }
+
+  /// Return the number of bytes held by the allocators of all threads.
+  size_t getTotalMemory() const {
+    std::lock_guard<std::mutex> Guard(Lock);
+    size_t TotalMemory = 0;
+    for (auto &Alloc : Allocators)
+      TotalMemory += Alloc->getTotalMemory();
+    return TotalMemory;
+  }
+
+  /// Return the number of bytes allocated by all threads.
+  size_t getBytesAllocated() const {
+    std::lock_guard<std::mutex> Guard(Lock);
+    size_t BytesAllocated = 0;
+    for (auto &Alloc : Allocators)
+      BytesAllocated += Alloc->getBytesAllocated();
+    return BytesAllocated;
+  }
+
+  /// Return the number of allocators, i.e. the most threads that have used
+  /// the arena between two resets.
+  size_t getNumThreads() const {
+    std::lock_guard<std::mutex> Guard(Lock);
+    return Allocators.size();
+  }
+
+private:
+  std::vector<std::unique_ptr<AllocatorTy>> Allocators;
+
+  /// The number of allocators handed to threads since the last reset.
+  size_t NumInUse = 0;
+};
+
+using PerThreadBumpPtrAllocator = PerThreadAllocator<BumpPtrAllocator>;
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_PERTHREADBUMPPTRALLOCATOR_H
@@ -55,6 +55,7 @@
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Regex.h"
 #include "llvm/Support/TrigramIndex.h"
+#include <map>
 #include <string>
 #include <vector>
 
@@ -113,7 +114,10 @@ protected:
   /// Represents a set of regular expressions.  Regular expressions which are
   /// "literal" (i.e. no regex metacharacters) are stored in Strings.  The
   /// reason for doing so is efficiency; StringMap is much faster at matching
-  /// literal strings than Regex.
+  /// literal strings than Regex.  For the same reason, wildcard expressions
+  /// that are a literal with a leading or trailing '*', or both, the most
+  /// common entries of large lists, are matched by suffix, prefix or
+  /// substring, and only the remaining ones are compiled to a Regex.
   class Matcher {
   public:
     bool insert(std::string Regexp, unsigned LineNumber, std::string &REError);
@@ -122,9 +126,44 @@ protected:
     unsigned match(StringRef Query) const;
 
   private:
+    /// A set of literals, in which queries look for the first inserted
+    /// literal that is a prefix of the query.
+    class PrefixSet {
+    public:
+      void insert(StringRef Prefix, unsigned Index, unsigned LineNumber);
+      /// If a literal of the set is a prefix of \p Query, and was inserted
+      /// before \p Index, sets \p Index and \p LineNumber to the ones of the
+      /// first such literal.
+      void match(StringRef Query, unsigned &Index, unsigned &LineNumber) const;
+      bool empty() const { return Literals.empty(); }
+
+    private:
+      /// The first inserted entry among a literal and all its prefixes in the
+      /// set, which is the one a query matching the literal returns.
+      struct FirstMatch {
+        unsigned Index;
+        unsigned LineNumber;
+      };
+      const FirstMatch *findLongestPrefix(StringRef Query) const;
+
+      std::map<std::string, FirstMatch, std::less<>> Literals;
+    };
+
     StringMap<unsigned> Strings;
+    PrefixSet Prefixes;
+    /// The literals of suffix matching expressions, reversed.
+    PrefixSet ReversedSuffixes;
+    struct Substring {
+      std::string Literal;
+      unsigned Index;
+      unsigned LineNumber;
+    };
+    std::vector<Substring> Substrings;
     TrigramIndex Trigrams;
     std::vector<std::pair<std::unique_ptr<Regex>, unsigned>> RegExes;
+    /// The insertion order of RegExes among all the non-literal expressions.
+    std::vector<unsigned> RegExIndices;
+    unsigned NumWildcards = 0;
   };
 
   using SectionEntries = StringMap<StringMap<Matcher>>;
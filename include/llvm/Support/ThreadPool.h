@@ -14,6 +14,7 @@
 #define LLVM_SUPPORT_THREAD_POOL_H
 
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/WorkStealingExecutor.h"
 #include "llvm/Support/thread.h"
 
 #include <future>
@@ -31,8 +32,10 @@ namespace llvm {
 /// A ThreadPool for asynchronous parallel execution on a defined number of
 /// threads.
 ///
-/// The pool keeps a vector of threads alive, waiting on a condition variable
-/// for some work to become available.
+/// The pool owns a WorkStealingExecutor whose threads stay alive, waiting for
+/// some work to become available. Tasks submitted from within the pool's own
+/// tasks go onto the submitting worker's deque, where idle workers can steal
+/// them.
 class ThreadPool {
 public:
   using TaskTy = std::function<void()>;
@@ -73,26 +76,22 @@ private:
   /// used to wait for the task to finish and is *non-blocking* on destruction.
   std::shared_future<void> asyncImpl(TaskTy F);
 
-  /// Threads in flight
-  std::vector<llvm::thread> Threads;
-
-  /// Tasks waiting for execution in the pool.
-  std::queue<PackagedTaskTy> Tasks;
-
-  /// Locking and signaling for accessing the Tasks queue.
-  std::mutex QueueLock;
-  std::condition_variable QueueCondition;
+#if LLVM_ENABLE_THREADS
+  /// Threads in flight and their task deques.
+  std::unique_ptr<WorkStealingExecutor> Executor;
 
   /// Locking and signaling for job completion
   std::mutex CompletionLock;
   std::condition_variable CompletionCondition;
 
-  /// Keep track of the number of thread actually busy
-  std::atomic<unsigned> ActiveThreads;
+  /// Keep track of the number of tasks submitted but not yet completed.
+  std::atomic<unsigned> OutstandingTasks;
 
-#if LLVM_ENABLE_THREADS // avoids warning for unused variable
   /// Signal for the destruction of the pool, asking thread to exit.
   bool EnableFlag;
+#else
+  /// Tasks waiting for execution in the pool.
+  std::queue<PackagedTaskTy> Tasks;
 #endif
 };
 }
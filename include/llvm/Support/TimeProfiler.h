@@ -9,27 +9,36 @@
 #ifndef LLVM_SUPPORT_TIME_PROFILER_H
 #define LLVM_SUPPORT_TIME_PROFILER_H
 
+#include "llvm/Support/Compiler.h"
 #include "llvm/Support/raw_ostream.h"
 
 namespace llvm {
 
 struct TimeTraceProfiler;
-extern TimeTraceProfiler *TimeTraceProfilerInstance;
+extern LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance;
 
 /// Initialize the time trace profiler.
-/// This sets up the global \p TimeTraceProfilerInstance
-/// variable to be the profiler instance.
-void timeTraceProfilerInitialize(unsigned TimeTraceGranularity);
+/// This sets up the thread-local \p TimeTraceProfilerInstance
+/// variable to be the profiler instance of the calling thread.
+/// \p ProcName names the process in the trace written by the main thread.
+void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
+                                 StringRef ProcName = "clang");
 
-/// Cleanup the time trace profiler, if it was initialized.
+/// Cleanup the time trace profiler, if it was initialized. This also deletes
+/// the profilers of the threads that called timeTraceProfilerFinishThread().
 void timeTraceProfilerCleanup();
 
+/// Finish the time trace profiler of a worker thread. Its events are kept and
+/// written as a separate track by timeTraceProfilerWrite().
+void timeTraceProfilerFinishThread();
+
 /// Is the time trace profiler enabled, i.e. initialized?
 inline bool timeTraceProfilerEnabled() {
   return TimeTraceProfilerInstance != nullptr;
 }
 
-/// Write profiling data to output file.
+/// Write profiling data to output file. The events of the calling thread and
+/// of all finished threads are merged, with one track per thread.
 /// Data produced is JSON, in Chrome "Trace Event" format, see
 /// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview
 void timeTraceProfilerWrite(raw_pwrite_stream &OS);
@@ -0,0 +1,117 @@
+//===-- llvm/Support/WorkStealingExecutor.h - Work-stealing tasks -*- C++ -*-=//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines a work-stealing executor shared by ThreadPool and the
+// parallel algorithms in Parallel.h.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_WORKSTEALINGEXECUTOR_H
+#define LLVM_SUPPORT_WORKSTEALINGEXECUTOR_H
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+
+#if LLVM_ENABLE_THREADS
+
+/// An executor that runs closures on a fixed set of worker threads, each
+/// owning its own task deque.
+///
+/// Tasks submitted from a worker thread are pushed onto that worker's deque
+/// and popped in LIFO order, which keeps recursively spawned work cache-hot.
+/// Tasks submitted from any other thread go to a shared injection queue. An
+/// idle worker first drains its own deque, then the injection queue, and then
+/// steals the oldest task from the other workers' deques. Every deque has its
+/// own lock, so there is no single queue that all threads contend on.
+///
+/// A thread that needs to block until some condition holds (for instance a
+/// TaskGroup waiting for the tasks it spawned) should call helpUntil(), which
+/// keeps executing queued tasks while it waits. This makes nested parallelism
+/// deadlock-free even when every worker is waiting on a nested task group.
+class WorkStealingExecutor {
+public:
+  using TaskTy = std::function<void()>;
+
+  /// Construct an executor with \p ThreadCount worker threads.
+  explicit WorkStealingExecutor(unsigned ThreadCount = hardware_concurrency());
+
+  /// Blocking destructor: runs all queued tasks and joins the workers.
+  ~WorkStealingExecutor();
+
+  WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+  WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+  /// Queue \p F for asynchronous execution.
+  void add(TaskTy F);
+
+  /// Pop one queued task, if any, and run it on the calling thread. Returns
+  /// false if no task could be found.
+  bool runOneTask();
+
+  /// Run queued tasks on the calling thread until \p Done returns true.
+  /// Sleeps while there is no work to do. \p Done is re-evaluated each time a
+  /// task finishes on any thread of this executor.
+  void helpUntil(function_ref<bool()> Done);
+
+  /// Return true if the calling thread is one of this executor's workers.
+  bool isWorkerThread() const;
+
+  unsigned getThreadCount() const { return Queues.size() - 1; }
+
+  /// The process-wide executor used by the parallel algorithms.
+  static WorkStealingExecutor &getDefault();
+
+private:
+  struct WorkQueue {
+    std::mutex Lock;
+    std::deque<TaskTy> Tasks;
+  };
+
+  void work(unsigned Index);
+  bool popTask(unsigned Self, TaskTy &Task);
+  void runTask(TaskTy &Task);
+
+  /// One deque per worker, followed by the injection queue used by threads
+  /// that are not workers of this executor.
+  std::vector<std::unique_ptr<WorkQueue>> Queues;
+
+  std::vector<llvm::thread> Threads;
+
+  /// Number of tasks that have been queued but not yet popped.
+  std::atomic<unsigned> Pending{0};
+
+  /// Number of workers and helpers blocked on the condition variables below.
+  std::atomic<unsigned> SleepingWorkers{0};
+  std::atomic<unsigned> SleepingHelpers{0};
+
+  std::mutex SleepLock;
+  std::condition_variable WorkerCondition;
+  std::condition_variable HelperCondition;
+
+  /// Signal for the destruction of the executor, asking workers to exit once
+  /// the queues are drained.
+  bool Stop = false;
+};
+
+#endif // LLVM_ENABLE_THREADS
+
+} // namespace llvm
+
+#endif // LLVM_SUPPORT_WORKSTEALINGEXECUTOR_H
@@ -101,6 +101,13 @@ public:
 
   /// Hash a function. Equivalent functions will have the same hash, and unequal
   /// functions will have different hashes with high probability.
+  ///
+  /// The hash only looks at the shape of the function, not at its operands, so
+  /// it is meant for finding merge candidates. It is not a cache key for the
+  /// optimized body of a function: besides the operands, that body depends on
+  /// the callees the inliner could see and on what interprocedural passes
+  /// derived from the rest of the module. The ThinLTO cache keys the
+  /// optimized result on the module and its imports instead.
   using FunctionHash = uint64_t;
   static FunctionHash functionHash(Function &);
 
@@ -0,0 +1,190 @@
+//===- KnownBitsCache.cpp - Cached known bits of values -------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/KnownBitsCache.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+void KnownBitsCache::KnownBitsCallbackVH::deleted() {
+  KBC->invalidateValue(getValPtr());
+}
+
+void KnownBitsCache::KnownBitsCallbackVH::allUsesReplacedWith(Value *) {
+  // The users are about to be rewritten to use the new value, which may be
+  // known to have different bits, so treat the old value as invalidated.
+  KBC->invalidateValue(getValPtr());
+}
+
+KnownBitsCache::KnownBitsCache(const Function &F, AssumptionCache *AC,
+                               const DominatorTree *DT)
+    : F(F), DL(F.getParent()->getDataLayout()), AC(AC), DT(DT) {}
+
+KnownBitsCache::CachedInfo *KnownBitsCache::getCachedInfo(const Value *V) {
+  if (!isa<Instruction>(V) && !isa<Argument>(V))
+    return nullptr;
+  auto It = Cache.find_as(V);
+  if (It == Cache.end())
+    It = Cache
+             .insert({KnownBitsCallbackVH(const_cast<Value *>(V), this),
+                      CachedInfo()})
+             .first;
+  return &It->second;
+}
+
+KnownBits KnownBitsCache::getKnownBits(const Value *V) {
+  CachedInfo *Info = getCachedInfo(V);
+  if (!Info)
+    return computeKnownBits(V, DL, 0, AC, nullptr, DT);
+  if (!Info->Known)
+    Info->Known = computeKnownBits(V, DL, 0, AC, nullptr, DT);
+  return *Info->Known;
+}
+
+unsigned KnownBitsCache::getNumSignBits(const Value *V) {
+  CachedInfo *Info = getCachedInfo(V);
+  if (!Info)
+    return ComputeNumSignBits(V, DL, 0, AC, nullptr, DT);
+  // There is always at least one sign bit, so 0 means not computed yet.
+  if (!Info->NumSignBits)
+    Info->NumSignBits = ComputeNumSignBits(V, DL, 0, AC, nullptr, DT);
+  return Info->NumSignBits;
+}
+
+bool KnownBitsCache::isKnownNonZero(const Value *V) {
+  CachedInfo *Info = getCachedInfo(V);
+  if (!Info)
+    return llvm::isKnownNonZero(V, DL, 0, AC, nullptr, DT);
+  if (!Info->NonZero)
+    Info->NonZero = llvm::isKnownNonZero(V, DL, 0, AC, nullptr, DT);
+  return *Info->NonZero;
+}
+
+ConstantRange KnownBitsCache::getConstantRange(const Value *V,
+                                               bool IsSigned) {
+  // Get the known bits first, as that may add V to the cache.
+  KnownBits Known = getKnownBits(V);
+  auto Compute = [&] {
+    // Combine the ranges as computeConstantRangeIncludingKnownBits does.
+    ConstantRange CR1 = ConstantRange::fromKnownBits(Known, IsSigned);
+    ConstantRange CR2 = computeConstantRange(V);
+    ConstantRange::PreferredRangeType RangeType =
+        IsSigned ? ConstantRange::Signed : ConstantRange::Unsigned;
+    return CR1.intersectWith(CR2, RangeType);
+  };
+  CachedInfo *Info = getCachedInfo(V);
+  if (!Info)
+    return Compute();
+  Optional<ConstantRange> &Range =
+      IsSigned ? Info->SignedRange : Info->UnsignedRange;
+  if (!Range)
+    Range = Compute();
+  return *Range;
+}
+
+void KnownBitsCache::invalidateValue(const Value *V) {
+  // The queries look through at most MaxAnalysisRecursionDepth levels of
+  // operands, so only the users of V up to that depth can have cached
+  // information that depends on it. Walk them breadth-first, so that every
+  // value is reached at its smallest depth.
+  SmallVector<std::pair<const Value *, unsigned>, 16> Worklist;
+  SmallPtrSet<const Value *, 16> Visited;
+  Worklist.push_back({V, 0});
+  Visited.insert(V);
+  for (unsigned I = 0; I != Worklist.size(); ++I) {
+    const Value *Cur = Worklist[I].first;
+    unsigned Depth = Worklist[I].second;
+    auto It = Cache.find_as(Cur);
+    if (It != Cache.end())
+      Cache.erase(It);
+    if (Depth == MaxAnalysisRecursionDepth)
+      continue;
+    for (const User *U : Cur->users())
+      if (Visited.insert(U).second)
+        Worklist.push_back({U, Depth + 1});
+  }
+}
+
+void KnownBitsCache::releaseMemory() { Cache.clear(); }
+
+void KnownBitsCache::print(raw_ostream &OS) const {
+  auto PrintValue = [&](const Value &V) {
+    auto It = Cache.find_as(&V);
+    if (It == Cache.end())
+      return;
+    const CachedInfo &Info = It->second;
+    OS << "  ";
+    V.printAsOperand(OS, false);
+    OS << ":";
+    if (Info.Known)
+      OS << " zero=0x" << Info.Known->Zero.toString(16, false) << " one=0x"
+         << Info.Known->One.toString(16, false);
+    if (Info.NumSignBits)
+      OS << " signbits=" << Info.NumSignBits;
+    if (Info.NonZero)
+      OS << (*Info.NonZero ? " nonzero" : " maybezero");
+    if (Info.UnsignedRange)
+      OS << " urange=" << *Info.UnsignedRange;
+    if (Info.SignedRange)
+      OS << " srange=" << *Info.SignedRange;
+    OS << "\n";
+  };
+  // Iterate through the function rather than through the cache in order to
+  // get predictable ordering.
+  for (const Argument &A : F.args())
+    PrintValue(A);
+  for (const Instruction &I : instructions(F))
+    PrintValue(I);
+}
+
+bool KnownBitsCache::invalidate(Function &F, const PreservedAnalyses &PA,
+                                FunctionAnalysisManager::Invalidator &Inv) {
+  // KnownBitsCache is invalidated if it isn't preserved, or if the analyses
+  // it was created with are invalidated.
+  auto PAC = PA.getChecker<KnownBitsAnalysis>();
+  if (!(PAC.preserved() || PAC.preservedSet<AllAnalysesOn<Function>>()))
+    return true;
+  return (AC && Inv.invalidate<AssumptionAnalysis>(F, PA)) ||
+         (DT && Inv.invalidate<DominatorTreeAnalysis>(F, PA));
+}
+
+AnalysisKey KnownBitsAnalysis::Key;
+KnownBitsCache KnownBitsAnalysis::run(Function &F,
+                                      FunctionAnalysisManager &AM) {
+  return KnownBitsCache(F, &AM.getResult<AssumptionAnalysis>(F),
+                        &AM.getResult<DominatorTreeAnalysis>(F));
+}
+
+PreservedAnalyses KnownBitsPrinterPass::run(Function &F,
+                                            FunctionAnalysisManager &AM) {
+  OS << "Known bits for function: " << F.getName() << "\n";
+  KnownBitsCache &KBC = AM.getResult<KnownBitsAnalysis>(F);
+  auto Query = [&](const Value &V) {
+    Type *Ty = V.getType();
+    if (!Ty->isIntOrIntVectorTy() && !Ty->isPtrOrPtrVectorTy())
+      return;
+    KBC.getKnownBits(&V);
+    if (Ty->isIntOrIntVectorTy())
+      KBC.getNumSignBits(&V);
+    KBC.isKnownNonZero(&V);
+  };
+  for (const Argument &A : F.args())
+    Query(A);
+  for (const Instruction &I : instructions(F))
+    Query(I);
+  KBC.print(OS);
+  return PreservedAnalyses::all();
+}
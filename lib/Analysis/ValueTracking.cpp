@@ -75,7 +75,7 @@
 using namespace llvm;
 using namespace llvm::PatternMatch;
 
-const unsigned MaxDepth = 6;
+const unsigned MaxDepth = MaxAnalysisRecursionDepth;
 
 // Controls the number of uses of the value searched for possible
 // dominating comparisons.
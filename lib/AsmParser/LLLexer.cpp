@@ -22,6 +22,7 @@
 #include <cassert>
 #include <cctype>
 #include <cstdio>
+#include <cstring>
 
 using namespace llvm;
 
@@ -251,6 +252,42 @@ void LLLexer::SkipLineComment() {
   }
 }
 
+/// SkipBracedBlock - Skip from the current '{' token to its matching '}',
+/// looking only for braces, strings and comments on the way rather than lexing
+/// every token, and lex the token after it.
+bool LLLexer::SkipBracedBlock() {
+  assert(CurKind == lltok::lbrace && "Not at a '{'");
+  const char *Ptr = TokStart + 1;
+  const char *End = CurBuf.end();
+  unsigned Depth = 1;
+  while (Ptr != End) {
+    switch (*Ptr++) {
+    case '{':
+      ++Depth;
+      break;
+    case '}':
+      if (--Depth == 0) {
+        CurPtr = Ptr;
+        Lex();
+        return false;
+      }
+      break;
+    case '"':
+      // Strings can't contain quotes, those are escaped as \22.
+      Ptr = static_cast<const char *>(memchr(Ptr, '"', End - Ptr));
+      if (!Ptr)
+        return Error("end of file in string constant");
+      ++Ptr;
+      break;
+    case ';':
+      while (Ptr != End && *Ptr != '\n' && *Ptr != '\r')
+        ++Ptr;
+      break;
+    }
+  }
+  return Error("expected matching '}'");
+}
+
 /// Lex all tokens that start with an @ character.
 ///   GlobalVar   @\"[^\"]*\"
 ///   GlobalVar   @[-a-zA-Z$._][-a-zA-Z$._0-9]*
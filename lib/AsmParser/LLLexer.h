@@ -53,6 +53,17 @@ namespace llvm {
       return CurKind = LexToken();
     }
 
+    /// Go back or ahead to \p Loc, which must be the start of a token that was
+    /// lexed before, and lex it again.
+    lltok::Kind LexFrom(SMLoc Loc) {
+      CurPtr = Loc.getPointer();
+      return Lex();
+    }
+
+    /// At a '{', skip over everything up to the matching '}'. Return true on
+    /// error.
+    bool SkipBracedBlock();
+
     typedef SMLoc LocTy;
     LocTy getLoc() const { return SMLoc::getFromPointer(TokStart); }
     lltok::Kind getKind() const { return CurKind; }
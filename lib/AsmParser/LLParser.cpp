@@ -61,7 +61,9 @@ static std::string getTypeString(Type *T) {
 }
 
 /// Run: module ::= toplevelentity*
-bool LLParser::Run() {
+bool LLParser::Run(bool LazyFunctionBodies) {
+  this->LazyFunctionBodies = LazyFunctionBodies;
+
   // Prime the lexer.
   Lex.Lex();
 
@@ -121,7 +123,86 @@ void LLParser::restoreParsingState(const SlotMapping *Slots) {
 bool LLParser::ValidateEndOfModule() {
   if (!M)
     return false;
-  // Handle any function attribute group forward references.
+
+  // Parse the bodies that blockaddress constants refer to if they were
+  // skipped, so the references can be resolved.
+  if (MaterializeBlockAddressFunctions())
+    return true;
+
+  ResolveForwardRefAttrGroups();
+
+  if (ValidateForwardRefs())
+    return true;
+
+  // Resolve metadata cycles.
+  for (auto &N : NumberedMetadata) {
+    if (N.second && !N.second->isResolved())
+      N.second->resolveCycles();
+  }
+
+  UpgradeTBAATags();
+
+  if (LazyFunctionBodies) {
+    // Upgrade the calls that were parsed so far, and keep the old functions
+    // around for the bodies that haven't been, as the bitcode reader does.
+    for (Function &F : *M) {
+      if (!F.getName().startswith("llvm."))
+        continue;
+      std::string Name = F.getName();
+      Function *NewFn;
+      if (UpgradeIntrinsicFunction(&F, NewFn)) {
+        UpgradedIntrinsics[&F] = NewFn;
+        if (F.getName() != Name)
+          UpgradedIntrinsicNames[Name] = &F;
+      } else if (auto Remangled = Intrinsic::remangleIntrinsicFunction(&F)) {
+        RemangledIntrinsics[&F] = Remangled.getValue();
+      }
+    }
+    UpgradeIntrinsicUses();
+  } else {
+    // Look for intrinsic functions and CallInst that need to be upgraded
+    for (Module::iterator FI = M->begin(), FE = M->end(); FI != FE; )
+      UpgradeCallsToIntrinsic(&*FI++); // must be post-increment, as we remove
+
+    // Some types could be renamed during loading if several modules are
+    // loaded in the same LLVMContext (LTO scenario). In this case we should
+    // remangle intrinsics names as well.
+    for (Module::iterator FI = M->begin(), FE = M->end(); FI != FE; ) {
+      Function *F = &*FI++;
+      if (auto Remangled = Intrinsic::remangleIntrinsicFunction(F)) {
+        F->replaceAllUsesWith(Remangled.getValue());
+        F->eraseFromParent();
+      }
+    }
+
+    // This verifies the module, so it has to wait for all the bodies when
+    // they're parsed lazily.
+    if (UpgradeDebugInfo)
+      llvm::UpgradeDebugInfo(*M);
+  }
+
+  UpgradeModuleFlags(*M);
+  UpgradeSectionAttributes(*M);
+
+  if (!Slots)
+    return false;
+  // Initialize the slot mapping.
+  // Because by this point we've parsed and validated everything, we can "steal"
+  // the mapping from LLParser as it doesn't need it anymore.
+  assert(!LazyFunctionBodies && "Deferred bodies need the mapping");
+  Slots->GlobalValues = std::move(NumberedVals);
+  Slots->MetadataNodes = std::move(NumberedMetadata);
+  for (const auto &I : NamedTypes)
+    Slots->NamedTypes.insert(std::make_pair(I.getKey(), I.second.first));
+  for (const auto &I : NumberedTypes)
+    Slots->Types.insert(std::make_pair(I.first, I.second.first));
+
+  return false;
+}
+
+/// ResolveForwardRefAttrGroups - Apply the attribute groups that functions,
+/// calls and globals referred to before the groups were defined.
+void LLParser::ResolveForwardRefAttrGroups() {
   for (const auto &RAG : ForwardRefAttrGroups) {
     Value *V = RAG.first;
     const std::vector<unsigned> &Attrs = RAG.second;
@@ -179,13 +260,12 @@ bool LLParser::ValidateEndOfModule() {
       llvm_unreachable("invalid object with forward attribute group reference");
     }
   }
+  ForwardRefAttrGroups.clear();
+}
 
-  // If there are entries in ForwardRefBlockAddresses at this point, the
-  // function was never defined.
-  if (!ForwardRefBlockAddresses.empty())
-    return Error(ForwardRefBlockAddresses.begin()->first.Loc,
-                 "expected function name in blockaddress");
-
+/// ValidateForwardRefs - Check that everything that was referred to before
+/// being defined got defined.
+bool LLParser::ValidateForwardRefs() {
   for (const auto &NT : NumberedTypes)
     if (NT.second.second.isValid())
       return Error(NT.second.second,
@@ -217,12 +297,12 @@ bool LLParser::ValidateEndOfModule() {
                  "use of undefined metadata '!" +
                  Twine(ForwardRefMDNodes.begin()->first) + "'");
 
-  // Resolve metadata cycles.
-  for (auto &N : NumberedMetadata) {
-    if (N.second && !N.second->isResolved())
-      N.second->resolveCycles();
-  }
+  return false;
+}
 
+/// UpgradeTBAATags - Upgrade the old-style TBAA tags of the instructions
+/// parsed so far.
+void LLParser::UpgradeTBAATags() {
   for (auto *Inst : InstsWithTBAATag) {
     MDNode *MD = Inst->getMetadata(LLVMContext::MD_tbaa);
     assert(MD && "UpgradeInstWithTBAATag should have a TBAA tag");
@@ -230,41 +310,71 @@ bool LLParser::ValidateEndOfModule() {
     if (MD != UpgradedMD)
       Inst->setMetadata(LLVMContext::MD_tbaa, UpgradedMD);
   }
+  InstsWithTBAATag.clear();
+}
+
+/// ValidateMaterializedFunctions - Do what ValidateEndOfModule does for
+/// function bodies, for those that were parsed after the module.
+bool LLParser::ValidateMaterializedFunctions() {
+  ResolveForwardRefAttrGroups();
+  if (ValidateForwardRefs())
+    return true;
+  UpgradeTBAATags();
+  UpgradeIntrinsicUses();
+  return false;
+}
 
-  // Look for intrinsic functions and CallInst that need to be upgraded
-  for (Module::iterator FI = M->begin(), FE = M->end(); FI != FE; )
-    UpgradeCallsToIntrinsic(&*FI++); // must be post-increment, as we remove
+/// UpgradeIntrinsicUses - Upgrade the uses of the intrinsics that were
+/// upgraded or remangled, in the function bodies parsed so far.
+void LLParser::UpgradeIntrinsicUses() {
+  for (auto &I : UpgradedIntrinsics)
+    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
+         UI != UE;)
+      if (CallInst *CI = dyn_cast<CallInst>(*UI++))
+        UpgradeIntrinsicCall(CI, I.second);
+  for (auto &I : RemangledIntrinsics)
+    for (auto UI = I.first->materialized_user_begin(), UE = I.first->user_end();
+         UI != UE;)
+      // Don't expect any other users than call sites
+      cast<CallBase>(*UI++)->setCalledFunction(I.second);
+}
 
-  // Some types could be renamed during loading if several modules are
-  // loaded in the same LLVMContext (LTO scenario). In this case we should
-  // remangle intrinsics names as well.
-  for (Module::iterator FI = M->begin(), FE = M->end(); FI != FE; ) {
-    Function *F = &*FI++;
-    if (auto Remangled = Intrinsic::remangleIntrinsicFunction(F)) {
-      F->replaceAllUsesWith(Remangled.getValue());
-      F->eraseFromParent();
-    }
+bool LLParser::materializeFunction(Function &F) {
+  return ParseDeferredFunctionBody(F) || MaterializeBlockAddressFunctions() ||
+         ValidateMaterializedFunctions();
+}
+
+bool LLParser::materializeModule() {
+  if (ParseDeferredFunctionBodies() || MaterializeBlockAddressFunctions() ||
+      ValidateMaterializedFunctions())
+    return true;
+
+  // Now that no body is left to refer to them, remove the old intrinsics.
+  for (auto &I : UpgradedIntrinsics) {
+    if (!I.first->use_empty())
+      I.first->replaceAllUsesWith(I.second);
+    I.first->eraseFromParent();
   }
+  UpgradedIntrinsics.clear();
+  UpgradedIntrinsicNames.clear();
+  for (auto &I : RemangledIntrinsics)
+    I.first->eraseFromParent();
+  RemangledIntrinsics.clear();
 
   if (UpgradeDebugInfo)
     llvm::UpgradeDebugInfo(*M);
+  return false;
+}
 
-  UpgradeModuleFlags(*M);
-  UpgradeSectionAttributes(*M);
-
-  if (!Slots)
-    return false;
-  // Initialize the slot mapping.
-  // Because by this point we've parsed and validated everything, we can "steal"
-  // the mapping from LLParser as it doesn't need it anymore.
-  Slots->GlobalValues = std::move(NumberedVals);
-  Slots->MetadataNodes = std::move(NumberedMetadata);
+std::vector<StructType *> LLParser::getIdentifiedStructTypes() const {
+  std::vector<StructType *> Types;
   for (const auto &I : NamedTypes)
-    Slots->NamedTypes.insert(std::make_pair(I.getKey(), I.second.first));
+    if (auto *STy = dyn_cast<StructType>(I.second.first))
+      Types.push_back(STy);
   for (const auto &I : NumberedTypes)
-    Slots->Types.insert(std::make_pair(I.first, I.second.first));
-
-  return false;
+    if (auto *STy = dyn_cast<StructType>(I.second.first))
+      Types.push_back(STy);
+  return Types;
 }
 
 /// Do final validity and sanity checks at the end of the index.
@@ -506,9 +616,15 @@ bool LLParser::ParseDefine() {
   Lex.Lex();
 
   Function *F;
-  return ParseFunctionHeader(F, true) ||
-         ParseOptionalFunctionMetadata(*F) ||
-         ParseFunctionBody(*F);
+  if (ParseFunctionHeader(F, true) || ParseOptionalFunctionMetadata(*F))
+    return true;
+
+  int FunctionNumber = -1;
+  if (!F->hasName()) FunctionNumber = NumberedVals.size()-1;
+
+  if (LazyFunctionBodies)
+    return SkipFunctionBody(*F, FunctionNumber);
+  return ParseFunctionBody(*F, FunctionNumber);
 }
 
 /// ParseGlobalType
@@ -1406,9 +1522,13 @@ GlobalValue *LLParser::GetGlobalVal(const std::string &Name, Type *Ty,
     return nullptr;
   }
 
-  // Look this name up in the normal function symbol table.
-  GlobalValue *Val =
-    cast_or_null<GlobalValue>(M->getValueSymbolTable().lookup(Name));
+  // Look this name up in the normal function symbol table, unless it's the
+  // original name of an upgraded intrinsic.
+  GlobalValue *Val = nullptr;
+  if (!UpgradedIntrinsicNames.empty())
+    Val = UpgradedIntrinsicNames.lookup(Name);
+  if (!Val)
+    Val = cast_or_null<GlobalValue>(M->getValueSymbolTable().lookup(Name));
 
   // If this is a forward reference for the value, see if we already created a
   // forward ref record.
@@ -3258,6 +3378,10 @@ bool LLParser::ParseValID(ValID &ID, PerFunctionState *PFS) {
       F = cast<Function>(GV);
       if (F->isDeclaration())
         return Error(Fn.Loc, "cannot take blockaddress inside a declaration");
+      // If its body was skipped, refer to the block as if the function
+      // wasn't defined yet.
+      if (F->isMaterializable())
+        F = nullptr;
     }
 
     if (!F) {
@@ -5572,14 +5696,11 @@ bool LLParser::PerFunctionState::resolveForwardRefBlockAddresses() {
 
 /// ParseFunctionBody
 ///   ::= '{' BasicBlock+ UseListOrderDirective* '}'
-bool LLParser::ParseFunctionBody(Function &Fn) {
+bool LLParser::ParseFunctionBody(Function &Fn, int FunctionNumber) {
   if (Lex.getKind() != lltok::lbrace)
     return TokError("expected '{' in function body");
   Lex.Lex();  // eat the {.
 
-  int FunctionNumber = -1;
-  if (!Fn.hasName()) FunctionNumber = NumberedVals.size()-1;
-
   PerFunctionState PFS(*this, Fn, FunctionNumber);
 
   // Resolve block addresses and allow basic blocks to be forward-declared
@@ -5607,6 +5728,79 @@ bool LLParser::ParseFunctionBody(Function &Fn) {
   return PFS.FinishFunction();
 }
 
+/// SkipFunctionBody - Remember where the body of Fn is, and skip over it.
+bool LLParser::SkipFunctionBody(Function &Fn, int FunctionNumber) {
+  if (Lex.getKind() != lltok::lbrace)
+    return TokError("expected '{' in function body");
+
+  DeferredFunctionBody &Deferred = DeferredFunctionBodies[&Fn];
+  Deferred.Body = Lex.getLoc();
+  Deferred.FunctionNumber = FunctionNumber;
+  SmallVector<std::pair<unsigned, MDNode *>, 1> MDs;
+  Fn.getAllMetadata(MDs);
+  for (const auto &MD : MDs)
+    Deferred.Attachments.emplace_back(MD.first, TrackingMDNodeRef(MD.second));
+  Fn.clearMetadata();
+  Fn.setIsMaterializable(true);
+
+  return Lex.SkipBracedBlock();
+}
+
+/// ParseDeferredFunctionBody - Parse the body of Fn if it was skipped, and
+/// continue from where the parser was.
+bool LLParser::ParseDeferredFunctionBody(Function &Fn) {
+  auto I = DeferredFunctionBodies.find(&Fn);
+  if (I == DeferredFunctionBodies.end())
+    return false;
+  DeferredFunctionBody Deferred = std::move(I->second);
+  DeferredFunctionBodies.erase(I);
+
+  Fn.setIsMaterializable(false);
+  for (const auto &MD : Deferred.Attachments)
+    Fn.addMetadata(MD.first, *MD.second);
+
+  LocTy Resume = Lex.getLoc();
+  Lex.LexFrom(Deferred.Body);
+  if (ParseFunctionBody(Fn, Deferred.FunctionNumber))
+    return true;
+  Lex.LexFrom(Resume);
+  return false;
+}
+
+/// ParseDeferredFunctionBodies - Parse all the function bodies that were
+/// skipped so far, in the order of the module.
+bool LLParser::ParseDeferredFunctionBodies() {
+  if (DeferredFunctionBodies.empty())
+    return false;
+  for (Function &F : *M)
+    if (ParseDeferredFunctionBody(F))
+      return true;
+  return false;
+}
+
+/// MaterializeBlockAddressFunctions - Parse the skipped bodies of the functions
+/// that blockaddress constants refer to, which resolves those.
+bool LLParser::MaterializeBlockAddressFunctions() {
+  while (!ForwardRefBlockAddresses.empty()) {
+    const ValID &Fn = ForwardRefBlockAddresses.begin()->first;
+    GlobalValue *GV = nullptr;
+    if (Fn.Kind == ValID::t_GlobalID) {
+      if (Fn.UIntVal < NumberedVals.size())
+        GV = NumberedVals[Fn.UIntVal];
+    } else {
+      GV = M->getNamedValue(Fn.StrVal);
+    }
+
+    // If the function wasn't skipped, it was never defined.
+    auto *F = dyn_cast_or_null<Function>(GV);
+    if (!F || !DeferredFunctionBodies.count(F))
+      return Error(Fn.Loc, "expected function name in blockaddress");
+    if (ParseDeferredFunctionBody(*F))
+      return true;
+  }
+  return false;
+}
+
 /// ParseBasicBlock
 ///   ::= (LabelStr|LabelID)? Instruction*
 bool LLParser::ParseBasicBlock(PerFunctionState &PFS) {
@@ -7387,6 +7581,10 @@ bool LLParser::ParseUseListOrderIndexes(SmallVectorImpl<unsigned> &Indexes) {
 /// ParseUseListOrder
 ///   ::= 'uselistorder' Type Value ',' UseListOrderIndexes
 bool LLParser::ParseUseListOrder(PerFunctionState *PFS) {
+  // The uses of globals include those in function bodies.
+  if (!PFS && ParseDeferredFunctionBodies())
+    return true;
+
   SMLoc Loc = Lex.getLoc();
   if (ParseToken(lltok::kw_uselistorder, "expected uselistorder directive"))
     return true;
@@ -7405,6 +7603,8 @@ bool LLParser::ParseUseListOrder(PerFunctionState *PFS) {
 ///   ::= 'uselistorder_bb' @foo ',' %bar ',' UseListOrderIndexes
 bool LLParser::ParseUseListOrderBB() {
   assert(Lex.getKind() == lltok::kw_uselistorder_bb);
+  if (ParseDeferredFunctionBodies())
+    return true;
   SMLoc Loc = Lex.getLoc();
   Lex.Lex();
 
@@ -14,6 +14,7 @@
 #define LLVM_LIB_ASMPARSER_LLPARSER_H
 
 #include "LLLexer.h"
+#include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/IR/Attributes.h"
@@ -156,6 +157,28 @@ namespace llvm {
     // Map of module ID to path.
     std::map<unsigned, StringRef> ModuleIdMap;
 
+    /// Whether to skip function bodies, and parse them when they're
+    /// materialized.
+    bool LazyFunctionBodies = false;
+
+    // The function bodies that were skipped: where they start, the slot number
+    // of the function if it is unnamed, and its metadata attachments, which are
+    // set aside as unmaterialized functions can't have any.
+    struct DeferredFunctionBody {
+      LocTy Body;
+      int FunctionNumber;
+      SmallVector<std::pair<unsigned, TrackingMDNodeRef>, 1> Attachments;
+    };
+    std::map<Function *, DeferredFunctionBody> DeferredFunctionBodies;
+
+    // Intrinsics that were upgraded while function bodies that call them were
+    // deferred. The old functions are kept until the whole module is parsed,
+    // under the name they got by the upgrade, so the bodies' references to
+    // their original name are mapped to them.
+    MapVector<Function *, Function *> UpgradedIntrinsics;
+    MapVector<Function *, Function *> RemangledIntrinsics;
+    StringMap<Function *> UpgradedIntrinsicNames;
+
     /// Only the llvm-as tool may set this to false to bypass
     /// UpgradeDebuginfo so it can generate broken bitcode.
     bool UpgradeDebugInfo;
@@ -176,7 +199,23 @@ namespace llvm {
       if (!DataLayoutStr.empty())
         M->setDataLayout(DataLayoutStr);
     }
-    bool Run();
+    /// Parse the module. If \p LazyFunctionBodies is set, the function bodies
+    /// are only skipped over, and are parsed by materializeFunction or
+    /// materializeModule.
+    bool Run(bool LazyFunctionBodies = false);
+
+    /// Parse the body of \p F if it was skipped, along with those that it
+    /// refers to through blockaddress, and finish them as Run finishes the
+    /// module.
+    bool materializeFunction(Function &F);
+
+    /// Parse all the function bodies that were skipped, and do the upgrades
+    /// that need all of them.
+    bool materializeModule();
+
+    /// Return the identified struct types that the module defines, including
+    /// those only used by function bodies that weren't parsed yet.
+    std::vector<StructType *> getIdentifiedStructTypes() const;
 
     bool parseStandaloneConstantValue(Constant *&C, const SlotMapping *Slots);
 
@@ -307,6 +346,11 @@ namespace llvm {
     // Top-Level Entities
     bool ParseTopLevelEntities();
     bool ValidateEndOfModule();
+    void ResolveForwardRefAttrGroups();
+    bool ValidateForwardRefs();
+    void UpgradeTBAATags();
+    bool ValidateMaterializedFunctions();
+    void UpgradeIntrinsicUses();
     bool ValidateEndOfIndex();
     bool ParseTargetDefinition();
     bool ParseModuleAsm();
@@ -550,7 +594,11 @@ namespace llvm {
     };
     bool ParseArgumentList(SmallVectorImpl<ArgInfo> &ArgList, bool &isVarArg);
     bool ParseFunctionHeader(Function *&Fn, bool isDefine);
-    bool ParseFunctionBody(Function &Fn);
+    bool ParseFunctionBody(Function &Fn, int FunctionNumber);
+    bool SkipFunctionBody(Function &Fn, int FunctionNumber);
+    bool ParseDeferredFunctionBody(Function &Fn);
+    bool ParseDeferredFunctionBodies();
+    bool MaterializeBlockAddressFunctions();
     bool ParseBasicBlock(PerFunctionState &PFS);
 
     enum TailCallType { TCT_None, TCT_Tail, TCT_MustTail };
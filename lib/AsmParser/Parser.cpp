@@ -13,6 +13,8 @@
 #include "llvm/AsmParser/Parser.h"
 #include "LLParser.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/DebugInfo.h"
+#include "llvm/IR/GVMaterializer.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/ModuleSummaryIndex.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -51,6 +53,88 @@ llvm::parseAssembly(MemoryBufferRef F, SMDiagnostic &Err, LLVMContext &Context,
   return M;
 }
 
+namespace {
+
+/// Parses the function bodies that LLParser skipped when they're materialized.
+/// It owns the parser, and the buffer that it parses.
+class LazyAsmMaterializer : public GVMaterializer {
+  Module &M;
+  SourceMgr SM;
+  SMDiagnostic Diag;
+  LLParser Parser;
+  bool StripDebugInfo = false;
+
+  static StringRef addBuffer(SourceMgr &SM,
+                             std::unique_ptr<MemoryBuffer> Buffer) {
+    StringRef Text = Buffer->getBuffer();
+    SM.AddNewSourceBuffer(std::move(Buffer), SMLoc());
+    return Text;
+  }
+
+  Error error() const {
+    return make_error<StringError>(
+        Diag.getFilename() + ":" + Twine(Diag.getLineNo()) + ":" +
+            Twine(Diag.getColumnNo() + 1) + ": " + Diag.getMessage(),
+        inconvertibleErrorCode());
+  }
+
+public:
+  LazyAsmMaterializer(std::unique_ptr<MemoryBuffer> Buffer, Module &M,
+                      bool UpgradeDebugInfo, StringRef DataLayoutString)
+      : M(M), Parser(addBuffer(SM, std::move(Buffer)), SM, Diag, &M, nullptr,
+               M.getContext(), nullptr, UpgradeDebugInfo, DataLayoutString) {}
+
+  bool run(SMDiagnostic &Err) {
+    if (!Parser.Run(/*LazyFunctionBodies=*/true))
+      return false;
+    Err = Diag;
+    return true;
+  }
+
+  Error materialize(GlobalValue *GV) override {
+    Function *F = dyn_cast<Function>(GV);
+    if (!F || !F->isMaterializable())
+      return Error::success();
+    if (Parser.materializeFunction(*F))
+      return error();
+    if (StripDebugInfo)
+      stripDebugInfo(*F);
+    return Error::success();
+  }
+
+  Error materializeModule() override {
+    for (Function &F : M)
+      if (Error Err = materialize(&F))
+        return Err;
+    if (Parser.materializeModule())
+      return error();
+    return Error::success();
+  }
+
+  Error materializeMetadata() override { return Error::success(); }
+
+  void setStripDebugInfo() override { StripDebugInfo = true; }
+
+  std::vector<StructType *> getIdentifiedStructTypes() const override {
+    return Parser.getIdentifiedStructTypes();
+  }
+};
+
+} // end anonymous namespace
+
+std::unique_ptr<Module>
+llvm::parseAssemblyLazily(std::unique_ptr<MemoryBuffer> Buffer,
+                          SMDiagnostic &Err, LLVMContext &Context,
+                          bool UpgradeDebugInfo, StringRef DataLayoutString) {
+  auto M = std::make_unique<Module>(Buffer->getBufferIdentifier(), Context);
+  auto Materializer = std::make_unique<LazyAsmMaterializer>(
+      std::move(Buffer), *M, UpgradeDebugInfo, DataLayoutString);
+  if (Materializer->run(Err))
+    return nullptr;
+  M->setMaterializer(Materializer.release());
+  return M;
+}
+
 std::unique_ptr<Module>
 llvm::parseAssemblyFile(StringRef Filename, SMDiagnostic &Err,
                         LLVMContext &Context, SlotMapping *Slots,
@@ -101,6 +101,11 @@ static cl::opt<bool> DisableLazyLoading(
     cl::desc("Force disable the lazy-loading on-demand of metadata when "
              "loading bitcode for importing."));
 
+static cl::opt<bool> ForceLazyLoading(
+    "force-ondemand-mds-loading", cl::init(false), cl::Hidden,
+    cl::desc("Lazy-load module-level metadata on-demand for every module, "
+             "not only when loading bitcode for importing."));
+
 namespace {
 
 static int64_t unrotateSign(uint64_t U) { return (U & 1) ? ~(U >> 1) : U >> 1; }
@@ -905,8 +910,10 @@ Error MetadataLoader::MetadataLoaderImpl::parseMetadata(bool ModuleLevel) {
 
   // We lazy-load module-level metadata: we build an index for each record, and
   // then load individual record as needed, starting with the named metadata.
-  if (ModuleLevel && IsImporting && MetadataList.empty() &&
-      !DisableLazyLoading) {
+  // Metadata that is never reached from a named node, a global or a function
+  // body that gets materialized is never parsed.
+  if (ModuleLevel && (IsImporting || ForceLazyLoading) &&
+      MetadataList.empty() && !DisableLazyLoading) {
     auto SuccessOrErr = lazyLoadModuleMetadataBlock();
     if (!SuccessOrErr)
       return SuccessOrErr.takeError();
@@ -15,6 +15,7 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SwissTableMap.h"
 #include "llvm/ADT/UniqueVector.h"
 #include "llvm/IR/Attributes.h"
 #include "llvm/IR/Metadata.h"
@@ -59,7 +60,10 @@ private:
   TypeMapType TypeMap;
   TypeList Types;
 
-  using ValueMapType = DenseMap<const Value *, unsigned>;
+  /// Looked up for every operand the writer emits. SwissTableMap's grouped
+  /// probing makes writing bitcode measurably faster than with DenseMap; see
+  /// benchmarks/BitcodeWriter.cpp.
+  using ValueMapType = SwissTableMap<const Value *, unsigned>;
   ValueMapType ValueMap;
   ValueList Values;
 
@@ -88,7 +92,8 @@ private:
     }
   };
 
-  using MetadataMapType = DenseMap<const Metadata *, MDIndex>;
+  /// Looked up for every metadata operand and attachment; see ValueMap.
+  using MetadataMapType = SwissTableMap<const Metadata *, MDIndex>;
   MetadataMapType MetadataMap;
 
   /// Range of metadata IDs, as a half-open range.
@@ -15,6 +15,7 @@
 #include "SymbolizableObjectFile.h"
 
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/BinaryFormat/COFF.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/PDB/PDB.h"
@@ -34,6 +35,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <numeric>
+
+#define DEBUG_TYPE "symbolizer"
+
+STATISTIC(NumBinariesEvicted, "Number of binaries evicted from the cache");
 
 namespace llvm {
 namespace symbolize {
@@ -114,6 +120,59 @@ LLVMSymbolizer::symbolizeInlinedCode(const std::string &ModuleName,
   return InlinedContext;
 }
 
+Expected<std::vector<DIInliningInfo>>
+LLVMSymbolizer::symbolizeInlinedCode(
+    const std::string &ModuleName,
+    ArrayRef<object::SectionedAddress> ModuleOffsets) {
+  SymbolizableModule *Info;
+  if (auto InfoOrErr = getOrCreateModuleInfo(ModuleName))
+    Info = InfoOrErr.get();
+  else
+    return InfoOrErr.takeError();
+
+  std::vector<DIInliningInfo> Results(ModuleOffsets.size());
+  // A null module means an error has already been reported. Return empty
+  // results.
+  if (!Info)
+    return Results;
+
+  // Visit the offsets in address order. Neighbouring addresses usually belong
+  // to the same compile unit, so its DIEs and line table stay hot in the cache,
+  // and repeated addresses (common in large sets of stack traces) are resolved
+  // only once.
+  std::vector<unsigned> Order(ModuleOffsets.size());
+  std::iota(Order.begin(), Order.end(), 0);
+  llvm::stable_sort(Order, [&](unsigned LHS, unsigned RHS) {
+    return std::make_pair(ModuleOffsets[LHS].SectionIndex,
+                          ModuleOffsets[LHS].Address) <
+           std::make_pair(ModuleOffsets[RHS].SectionIndex,
+                          ModuleOffsets[RHS].Address);
+  });
+
+  const DIInliningInfo *Prev = nullptr;
+  for (unsigned I = 0, E = Order.size(); I != E; ++I) {
+    object::SectionedAddress ModuleOffset = ModuleOffsets[Order[I]];
+    DIInliningInfo &Result = Results[Order[I]];
+    if (Prev && ModuleOffsets[Order[I - 1]] == ModuleOffset) {
+      Result = *Prev;
+      continue;
+    }
+
+    if (Opts.RelativeAddresses)
+      ModuleOffset.Address += Info->getModulePreferredBase();
+    Result = Info->symbolizeInlinedCode(ModuleOffset, Opts.PrintFunctions,
+                                        Opts.UseSymbolTable);
+    if (Opts.Demangle) {
+      for (int i = 0, n = Result.getNumberOfFrames(); i < n; i++) {
+        auto *Frame = Result.getMutableFrame(i);
+        Frame->FunctionName = DemangleName(Frame->FunctionName, Info);
+      }
+    }
+    Prev = &Result;
+  }
+  return Results;
+}
+
 Expected<DIGlobal>
 LLVMSymbolizer::symbolizeData(const std::string &ModuleName,
                               object::SectionedAddress ModuleOffset) {
@@ -165,9 +224,52 @@ LLVMSymbolizer::symbolizeFrame(const std::string &ModuleName,
 
 void LLVMSymbolizer::flush() {
   ObjectForUBPathAndArch.clear();
+  LRUBinaries.clear();
+  CacheSize = 0;
   BinaryForPath.clear();
   ObjectPairForPathArch.clear();
   Modules.clear();
+  ModuleBinaries.clear();
+}
+
+void LLVMSymbolizer::pruneCache() {
+  if (!Opts.MaxCacheSize)
+    return;
+  while (CacheSize > Opts.MaxCacheSize && !LRUBinaries.empty()) {
+    CachedBinary &Bin = LRUBinaries.front();
+    CacheSize -= Bin.size();
+    LRUBinaries.pop_front();
+    Bin.evict();
+    ++NumBinariesEvicted;
+    BinaryForPath.erase(llvm::find_if(BinaryForPath, [&](const auto &Entry) {
+      return &Entry.second == &Bin;
+    }));
+  }
+}
+
+void LLVMSymbolizer::recordAccess(CachedBinary &Bin) {
+  LRUBinaries.splice(LRUBinaries.end(), LRUBinaries, Bin.getIterator());
+}
+
+void LLVMSymbolizer::CachedBinary::evict() {
+  // Evictors shared with other binaries erase themselves from all of them,
+  // this one included, so run them from a copy.
+  auto ToRun = std::move(Evictors);
+  Evictors.clear();
+  for (auto &Evictor : llvm::reverse(ToRun))
+    Evictor.second();
+}
+
+void LLVMSymbolizer::addEvictor(ArrayRef<CachedBinary *> Bins,
+                                std::function<void()> Evictor) {
+  unsigned Key = NextEvictorKey++;
+  SmallVector<CachedBinary *, 2> Owners(Bins.begin(), Bins.end());
+  for (CachedBinary *Bin : Bins)
+    Bin->pushEvictor(Key, [Key, Owners, Evictor] {
+      for (CachedBinary *Owner : Owners)
+        Owner->eraseEvictor(Key);
+      Evictor();
+    });
 }
 
 namespace {
@@ -360,7 +462,15 @@ LLVMSymbolizer::getOrCreateObjectPair(const std::string &Path,
   if (!DbgObj)
     DbgObj = Obj;
   ObjectPair Res = std::make_pair(Obj, DbgObj);
-  ObjectPairForPathArch.emplace(std::make_pair(Path, ArchName), Res);
+  auto Key = std::make_pair(Path, ArchName);
+  ObjectPairForPathArch.emplace(Key, Res);
+  SmallVector<CachedBinary *, 2> Bins;
+  for (const ObjectFile *O : {Obj, DbgObj}) {
+    CachedBinary *Bin = getCachedBinaryFor(O);
+    if (Bin && !is_contained(Bins, Bin))
+      Bins.push_back(Bin);
+  }
+  addEvictor(Bins, [this, Key] { ObjectPairForPathArch.erase(Key); });
   return Res;
 }
 
@@ -368,35 +478,40 @@ Expected<ObjectFile *>
 LLVMSymbolizer::getOrCreateObject(const std::string &Path,
                                   const std::string &ArchName) {
   Binary *Bin;
-  auto Pair = BinaryForPath.emplace(Path, OwningBinary<Binary>());
+  auto Pair = BinaryForPath.emplace(Path, CachedBinary());
+  CachedBinary &CachedBin = Pair.first->second;
   if (!Pair.second) {
-    Bin = Pair.first->second.getBinary();
+    Bin = CachedBin.Bin.getBinary();
+    if (Bin)
+      recordAccess(CachedBin);
   } else {
     Expected<OwningBinary<Binary>> BinOrErr = createBinary(Path);
     if (!BinOrErr)
       return BinOrErr.takeError();
-    Pair.first->second = std::move(BinOrErr.get());
-    Bin = Pair.first->second.getBinary();
+    CachedBin.Bin = std::move(BinOrErr.get());
+    Bin = CachedBin.Bin.getBinary();
+    LRUBinaries.push_back(CachedBin);
+    CacheSize += CachedBin.size();
   }
 
   if (!Bin)
     return static_cast<ObjectFile *>(nullptr);
 
   if (MachOUniversalBinary *UB = dyn_cast_or_null<MachOUniversalBinary>(Bin)) {
-    auto I = ObjectForUBPathAndArch.find(std::make_pair(Path, ArchName));
+    auto Key = std::make_pair(Path, ArchName);
+    auto I = ObjectForUBPathAndArch.find(Key);
     if (I != ObjectForUBPathAndArch.end())
       return I->second.get();
 
+    addEvictor(&CachedBin, [this, Key] { ObjectForUBPathAndArch.erase(Key); });
     Expected<std::unique_ptr<ObjectFile>> ObjOrErr =
         UB->getMachOObjectForArch(ArchName);
     if (!ObjOrErr) {
-      ObjectForUBPathAndArch.emplace(std::make_pair(Path, ArchName),
-                                     std::unique_ptr<ObjectFile>());
+      ObjectForUBPathAndArch.emplace(Key, std::unique_ptr<ObjectFile>());
       return ObjOrErr.takeError();
     }
     ObjectFile *Res = ObjOrErr->get();
-    ObjectForUBPathAndArch.emplace(std::make_pair(Path, ArchName),
-                                   std::move(ObjOrErr.get()));
+    ObjectForUBPathAndArch.emplace(Key, std::move(ObjOrErr.get()));
     return Res;
   }
   if (Bin->isObject()) {
@@ -405,6 +520,20 @@ LLVMSymbolizer::getOrCreateObject(const std::string &Path,
   return errorCodeToError(object_error::arch_not_found);
 }
 
+LLVMSymbolizer::CachedBinary *
+LLVMSymbolizer::getCachedBinaryFor(const ObjectFile *Obj) {
+  for (auto &Entry : BinaryForPath)
+    if (Entry.second.Bin.getBinary() == Obj)
+      return &Entry.second;
+  for (auto &Entry : ObjectForUBPathAndArch) {
+    if (Entry.second.get() != Obj)
+      continue;
+    auto I = BinaryForPath.find(Entry.first.first);
+    return I == BinaryForPath.end() ? nullptr : &I->second;
+  }
+  return nullptr;
+}
+
 Expected<SymbolizableModule *>
 LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
                                  std::unique_ptr<DIContext> Context,
@@ -425,8 +554,13 @@ LLVMSymbolizer::createModuleInfo(const ObjectFile *Obj,
 Expected<SymbolizableModule *>
 LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   auto I = Modules.find(ModuleName);
-  if (I != Modules.end())
+  if (I != Modules.end()) {
+    auto BinI = ModuleBinaries.find(ModuleName);
+    if (BinI != ModuleBinaries.end())
+      for (CachedBinary *Bin : BinI->second)
+        recordAccess(*Bin);
     return I->second.get();
+  }
 
   std::string BinaryName = ModuleName;
   std::string ArchName = Opts.DefaultArch;
@@ -470,7 +604,22 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
     Context =
         DWARFContext::create(*Objects.second, nullptr,
                              DWARFContext::defaultErrorHandler, Opts.DWPName);
-  return createModuleInfo(Objects.first, std::move(Context), ModuleName);
+  auto InfoOrErr =
+      createModuleInfo(Objects.first, std::move(Context), ModuleName);
+
+  // Drop the module when one of the binaries it was loaded from is evicted.
+  auto &Binaries = ModuleBinaries[ModuleName];
+  for (const ObjectFile *Obj : {Objects.first, Objects.second}) {
+    CachedBinary *Bin = getCachedBinaryFor(Obj);
+    if (!Bin || is_contained(Binaries, Bin))
+      continue;
+    Binaries.push_back(Bin);
+  }
+  addEvictor(Binaries, [this, ModuleName] {
+    Modules.erase(ModuleName);
+    ModuleBinaries.erase(ModuleName);
+  });
+  return InfoOrErr;
 }
 
 namespace {
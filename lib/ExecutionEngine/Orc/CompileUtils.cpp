@@ -55,6 +55,8 @@ SimpleCompiler::CompileResult SimpleCompiler::operator()(Module &M) {
 
   // TODO: Actually report errors helpfully.
   consumeError(Obj.takeError());
+  if (ObjCache)
+    ObjCache->notifyObjectCompileFailed(&M);
   return nullptr;
 }
 
@@ -1089,6 +1089,8 @@ Error JITDylib::emit(const SymbolFlagsMap &Emitted) {
             // Since this dependant is now ready, we erase its MaterializingInfo
             // and update its materializing state.
             DependantSymEntry.setState(SymbolState::Ready);
+            DependantJD.ReadySymbols.add(DependantName,
+                                         DependantSymEntry.getSymbol());
 
             for (auto &Q : DependantMI.takeQueriesMeeting(SymbolState::Ready)) {
               Q->notifySymbolMetRequiredState(
@@ -1106,6 +1108,7 @@ Error JITDylib::emit(const SymbolFlagsMap &Emitted) {
       MI.Dependants.clear();
       if (MI.UnemittedDependencies.empty()) {
         SymI->second.setState(SymbolState::Ready);
+        ReadySymbols.add(Name, SymI->second.getSymbol());
         for (auto &Q : MI.takeQueriesMeeting(SymbolState::Ready)) {
           Q->notifySymbolMetRequiredState(Name, SymI->second.getSymbol());
           if (Q->isComplete())
@@ -1339,6 +1342,8 @@ Error JITDylib::remove(const SymbolNameSet &Names) {
       }
 
       auto SymI = SymbolMaterializerItrPair.first;
+      if (SymI->second.getState() == SymbolState::Ready)
+        ReadySymbols.remove(SymI->first);
       Symbols.erase(SymI);
     }
 
@@ -1782,6 +1787,45 @@ Error JITDylib::defineImpl(MaterializationUnit &MU) {
   return Error::success();
 }
 
+void JITDylib::ReadySymbolTable::add(const SymbolStringPtr &Name,
+                                     JITEvaluatedSymbol Sym) {
+  auto &S = getShard(Name);
+  sys::SmartScopedWriter<true> Lock(S.Mutex);
+  S.Symbols[Name] = Sym;
+}
+
+void JITDylib::ReadySymbolTable::remove(const SymbolStringPtr &Name) {
+  auto &S = getShard(Name);
+  sys::SmartScopedWriter<true> Lock(S.Mutex);
+  S.Symbols.erase(Name);
+}
+
+bool JITDylib::ReadySymbolTable::lookup(const SymbolStringPtr &Name,
+                                        JITEvaluatedSymbol &Sym) const {
+  auto &S = getShard(Name);
+  sys::SmartScopedReader<true> Lock(S.Mutex);
+  auto I = S.Symbols.find(Name);
+  if (I == S.Symbols.end())
+    return false;
+  Sym = I->second;
+  return true;
+}
+
+bool JITDylib::lookupReady(const SymbolNameSet &Names, bool MatchNonExported,
+                           SymbolMap &Result) const {
+  for (auto &Name : Names) {
+    JITEvaluatedSymbol Sym;
+    if (!ReadySymbols.lookup(Name, Sym))
+      return false;
+    // A hidden symbol would be skipped by lodgeQuery, and the name resolved
+    // further down the search order instead.
+    if (!MatchNonExported && !Sym.getFlags().isExported())
+      return false;
+    Result[Name] = Sym;
+  }
+  return true;
+}
+
 void JITDylib::detachQueryHelper(AsynchronousSymbolQuery &Q,
                                  const SymbolNameSet &QuerySymbols) {
   for (auto &QuerySymbol : QuerySymbols) {
@@ -1943,6 +1987,18 @@ void ExecutionSession::lookup(
     });
   });
 
+  // If every symbol is already Ready in the first JITDylib searched, the
+  // result cannot depend on the rest of the search order or on any pending
+  // materialization, so answer without taking the session lock.
+  if (!SearchOrder.empty()) {
+    SymbolMap Result;
+    auto &KV = SearchOrder.front();
+    if (KV.first->lookupReady(Symbols, KV.second, Result)) {
+      NotifyComplete(std::move(Result));
+      return;
+    }
+  }
+
   // lookup can be re-entered recursively if running on a single thread. Run any
   // outstanding MUs in case this query depends on them, otherwise this lookup
   // will starve waiting for a result from an MU that is stuck in the queue.
@@ -0,0 +1,181 @@
+//===---- OnDiskObjectCache.cpp - Persistent object cache for ORC ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#define DEBUG_TYPE "orc"
+
+namespace llvm {
+namespace orc {
+
+/// Serialize everything in \p JTMB that affects the generated code.
+static std::string getConfigKey(const JITTargetMachineBuilder &JTMB) {
+  std::string Key;
+  raw_string_ostream OS(Key);
+  OS << LLVM_VERSION_STRING << '\0' << JTMB.getTargetTriple().str() << '\0'
+     << JTMB.getCPU() << '\0' << JTMB.getFeatures().getString() << '\0';
+
+  auto &RM = JTMB.getRelocationModel();
+  auto &CM = JTMB.getCodeModel();
+  OS << (RM ? static_cast<int>(*RM) : -1) << ','
+     << (CM ? static_cast<int>(*CM) : -1) << ','
+     << static_cast<int>(JTMB.getCodeGenOptLevel()) << ',';
+
+  const TargetOptions &Options = JTMB.getOptions();
+  OS << Options.EmulatedTLS << Options.ExplicitEmulatedTLS
+     << Options.RelaxELFRelocations << Options.FunctionSections
+     << Options.DataSections << Options.UniqueSectionNames
+     << Options.EnableFastISel << Options.EnableGlobalISel
+     << Options.UnsafeFPMath << Options.NoInfsFPMath << Options.NoNaNsFPMath
+     << Options.NoTrappingFPMath << Options.NoSignedZerosFPMath
+     << Options.HonorSignDependentRoundingFPMathOption
+     << Options.NoZerosInBSS << Options.GuaranteedTailCallOpt
+     << Options.EmitStackSizeSection << Options.EmitAddrsig
+     << Options.StackSymbolOrdering << Options.UseInitArray
+     << Options.DisableIntegratedAS << Options.TrapUnreachable
+     << Options.NoTrapAfterNoreturn << Options.EnableIPRA
+     << Options.EnableMachineOutliner << Options.SupportsDefaultOutlining
+     << Options.EnableDebugEntryValues << ','
+     << Options.StackAlignmentOverride << ','
+     << static_cast<int>(Options.CompressDebugSections) << ','
+     << static_cast<int>(Options.FloatABIType) << ','
+     << static_cast<int>(Options.AllowFPOpFusion) << ','
+     << static_cast<int>(Options.ThreadModel) << ','
+     << static_cast<int>(Options.EABIVersion) << ','
+     << static_cast<int>(Options.DebuggerTuning) << ','
+     << static_cast<int>(Options.FPDenormalMode) << ','
+     << static_cast<int>(Options.ExceptionModel) << '\0';
+
+  // The MC layer options also shape the object that is written.
+  const MCTargetOptions &MCOptions = Options.MCOptions;
+  OS << MCOptions.MCRelaxAll << MCOptions.MCNoExecStack
+     << MCOptions.MCFatalWarnings << MCOptions.MCNoWarn
+     << MCOptions.MCNoDeprecatedWarn << MCOptions.MCSaveTempLabels
+     << MCOptions.MCUseDwarfDirectory
+     << MCOptions.MCIncrementalLinkerCompatible
+     << MCOptions.MCPIECopyRelocations << MCOptions.ShowMCEncoding
+     << MCOptions.ShowMCInst << MCOptions.AsmVerbose
+     << MCOptions.PreserveAsmComments << ',' << MCOptions.DwarfVersion << ','
+     << MCOptions.ABIName << '\0' << MCOptions.SplitDwarfFile << '\0';
+  for (const std::string &Path : MCOptions.IASSearchPaths)
+    OS << Path << '\0';
+  return OS.str();
+}
+
+Expected<std::unique_ptr<OnDiskObjectCache>>
+OnDiskObjectCache::Create(StringRef CacheDir,
+                          const JITTargetMachineBuilder &JTMB,
+                          CachePruningPolicy Policy) {
+  if (auto EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+
+  std::unique_ptr<OnDiskObjectCache> Cache(
+      new OnDiskObjectCache(CacheDir, getConfigKey(JTMB), std::move(Policy)));
+  Cache->prune();
+  return std::move(Cache);
+}
+
+std::string OnDiskObjectCache::computeKey(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  {
+    raw_svector_ostream OS(Bitcode);
+    WriteBitcodeToFile(M, OS);
+  }
+
+  SHA1 Hasher;
+  Hasher.update(ConfigKey);
+  Hasher.update(ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(Bitcode.data()), Bitcode.size()));
+  return toHex(Hasher.result());
+}
+
+std::unique_ptr<MemoryBuffer> OnDiskObjectCache::getObject(const Module *M) {
+  std::string Key = computeKey(*M);
+
+  // This choice of file name allows the cache to be pruned (see pruneCache()
+  // in include/llvm/Support/CachePruning.h).
+  SmallString<128> EntryPath;
+  sys::path::append(EntryPath, CacheDir, "llvmcache-" + Key);
+  auto MBOrErr = MemoryBuffer::getFile(EntryPath, /*FileSize=*/-1,
+                                       /*RequiresNullTerminator=*/false);
+  if (MBOrErr) {
+    LLVM_DEBUG(dbgs() << "Object cache hit for " << M->getModuleIdentifier()
+                      << "\n");
+    return std::move(*MBOrErr);
+  }
+
+  // Remember the key for notifyObjectCompiled(): code generation may modify
+  // the module, so it cannot be recomputed from the module then.
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys[M] = std::move(Key);
+  return nullptr;
+}
+
+void OnDiskObjectCache::notifyObjectCompileFailed(const Module *M) {
+  std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+  PendingKeys.erase(M);
+}
+
+void OnDiskObjectCache::notifyObjectCompiled(const Module *M,
+                                             MemoryBufferRef Obj) {
+  std::string Key;
+  {
+    std::lock_guard<std::mutex> Lock(PendingKeysMutex);
+    auto I = PendingKeys.find(M);
+    if (I != PendingKeys.end()) {
+      Key = std::move(I->second);
+      PendingKeys.erase(I);
+    }
+  }
+  if (Key.empty())
+    Key = computeKey(*M);
+
+  SmallString<128> EntryPath;
+  sys::path::append(EntryPath, CacheDir, "llvmcache-" + Key);
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // readers (in this or another process) never see a partial object. The
+  // cache is only an optimization, so failures are not reported. The
+  // "llvmcache-" prefix lets pruneCache() remove the files that a process
+  // killed while writing leaves behind.
+  SmallString<128> TempFilenameModel;
+  sys::path::append(TempFilenameModel, CacheDir,
+                    "llvmcache-OrcJIT-%%%%%%.tmp.o");
+  auto Temp = sys::fs::TempFile::create(
+      TempFilenameModel, sys::fs::owner_read | sys::fs::owner_write);
+  if (!Temp) {
+    consumeError(Temp.takeError());
+    return;
+  }
+
+  {
+    raw_fd_ostream OS(Temp->FD, /*shouldClose=*/false);
+    OS << Obj.getBuffer();
+  }
+
+  if (auto Err = Temp->keep(EntryPath)) {
+    consumeError(std::move(Err));
+    consumeError(Temp->discard());
+  }
+}
+
+bool OnDiskObjectCache::prune() { return pruneCache(CacheDir, Policy); }
+
+} // end namespace orc
+} // end namespace llvm
@@ -67,11 +67,46 @@ DILocation *DILocation::getImpl(LLVMContext &Context, unsigned Line,
   Ops.push_back(Scope);
   if (InlinedAt)
     Ops.push_back(InlinedAt);
-  return storeImpl(new (Ops.size()) DILocation(Context, Storage, Line, Column,
-                                               Ops, ImplicitCode),
+  return storeImpl(new (Ops.size(), Context) DILocation(
+                       Context, Storage, Line, Column, Ops, ImplicitCode),
                    Storage, Context.pImpl->DILocations);
 }
 
+void *DILocation::operator new(size_t Size, unsigned NumOps,
+                               LLVMContext &Context) {
+  assert((NumOps == 1 || NumOps == 2) && "Expected scope and inlined-at");
+  LLVMContextImpl &Impl = *Context.pImpl;
+  char *Mem =
+      NumOps == 1
+          ? Impl.DILocationRecycler.Allocate<char>(Impl.DILocationAllocator)
+          : Impl.InlinedDILocationRecycler.Allocate<char>(
+                Impl.DILocationAllocator);
+
+  // Lay out the operands before the node, as MDNode::operator new does.
+  void *Ptr = Mem + NumOps * sizeof(MDOperand);
+  MDOperand *O = static_cast<MDOperand *>(Ptr);
+  for (MDOperand *E = O - NumOps; O != E; --O)
+    (void)new (O - 1) MDOperand;
+  return Ptr;
+}
+
+void DILocation::destroy() {
+  // Read what's needed to find the block before the node is gone.
+  unsigned NumOps = getNumOperands();
+  LLVMContextImpl &Impl = *getContext().pImpl;
+  void *Mem = this;
+  this->~DILocation();
+
+  MDOperand *O = static_cast<MDOperand *>(Mem);
+  for (MDOperand *E = O - NumOps; O != E; --O)
+    (O - 1)->~MDOperand();
+  char *Block = reinterpret_cast<char *>(O);
+  if (NumOps == 1)
+    Impl.DILocationRecycler.Deallocate(Impl.DILocationAllocator, Block);
+  else
+    Impl.InlinedDILocationRecycler.Deallocate(Impl.DILocationAllocator, Block);
+}
+
 const DILocation *DILocation::getMergedLocation(const DILocation *LocA,
                                                 const DILocation *LocB) {
   if (!LocA || !LocB)
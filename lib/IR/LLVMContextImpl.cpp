@@ -75,8 +75,10 @@ LLVMContextImpl::~LLVMContextImpl() {
     I->deleteAsSubclass();
 #define HANDLE_MDNODE_LEAF_UNIQUABLE(CLASS)                                    \
   for (CLASS * I : CLASS##s)                                                   \
-    delete I;
+    MDNode::deleteNode(I);
 #include "llvm/IR/Metadata.def"
+  DILocationRecycler.clear(DILocationAllocator);
+  InlinedDILocationRecycler.clear(DILocationAllocator);
 
   // Free the constants.
   for (auto *I : ExprConstants)
@@ -40,6 +40,7 @@
 #include "llvm/IR/TrackingMDRef.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/Recycler.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/YAMLTraits.h"
 #include <algorithm>
@@ -1239,6 +1240,13 @@ public:
   void getAll(SmallVectorImpl<std::pair<unsigned, MDNode *>> &Result) const;
 };
 
+/// The uniquing tables below (constants, types, attributes, metadata and value
+/// names) are plain DenseMaps and FoldingSets without any synchronization. IR
+/// construction interns into them implicitly from almost every factory
+/// function, and callers hold on to the returned pointers without a lock, so
+/// guarding individual tables would not make concurrent IR construction safe.
+/// Clients that want several threads to share one context must serialize all
+/// access to it, e.g. through orc::ThreadSafeContext.
 class LLVMContextImpl {
 public:
   /// OwnedModules - The set of modules instantiated in this context, and which
@@ -1279,6 +1287,17 @@ public:
   DenseSet<CLASS *, CLASS##Info> CLASS##s;
 #include "llvm/IR/Metadata.def"
 
+  // DILocations are the most numerous metadata nodes with debug info, and
+  // small enough that malloc's rounding and bookkeeping would add up to half
+  // again to each, so they're allocated here. There is one size for locations
+  // with only a scope operand, and one for those with an inlined-at operand
+  // too.
+  BumpPtrAllocator DILocationAllocator;
+  Recycler<DILocation, sizeof(DILocation) + sizeof(MDOperand)>
+      DILocationRecycler;
+  Recycler<DILocation, sizeof(DILocation) + 2 * sizeof(MDOperand)>
+      InlinedDILocationRecycler;
+
   // Optional map for looking up composite types by identifier.
   Optional<DenseMap<const MDString *, DICompositeType *>> DITypeMap;
 
@@ -745,13 +745,15 @@ void MDNode::handleChangedOperand(void *Ref, Metadata *New) {
   storeDistinctInContext();
 }
 
+void MDNode::deleteNode(DILocation *N) { N->destroy(); }
+
 void MDNode::deleteAsSubclass() {
   switch (getMetadataID()) {
   default:
     llvm_unreachable("Invalid subclass of MDNode");
 #define HANDLE_MDNODE_LEAF(CLASS)                                              \
   case CLASS##Kind:                                                            \
-    delete cast<CLASS>(this);                                                  \
+    deleteNode(cast<CLASS>(this));                                             \
     break;
 #include "llvm/IR/Metadata.def"
   }
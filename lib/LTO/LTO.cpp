@@ -38,6 +38,7 @@
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/VCSRevision.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
@@ -1083,6 +1084,8 @@ public:
       const std::map<GlobalValue::GUID, GlobalValue::LinkageTypes> &ResolvedODR,
       const GVSummaryMapTy &DefinedGlobals,
       MapVector<StringRef, BitcodeModule> &ModuleMap) {
+    TimeTraceScope TimeScope("ThinLTO backend", BM.getModuleIdentifier());
+
     auto RunThinBackend = [&](AddStreamFn AddStream) {
       LTOLLVMContext BackendContext(Conf);
       Expected<std::unique_ptr<Module>> MOrErr = BM.parseModule(BackendContext);
@@ -1131,9 +1134,17 @@ public:
                 &ResolvedODR,
             const GVSummaryMapTy &DefinedGlobals,
             MapVector<StringRef, BitcodeModule> &ModuleMap) {
+          // Without threads the job runs on the caller's thread, which
+          // already has a profiler.
+          bool ProfileThread =
+              Conf.TimeTraceEnabled && !timeTraceProfilerEnabled();
+          if (ProfileThread)
+            timeTraceProfilerInitialize(Conf.TimeTraceGranularity);
           Error E = runThinLTOBackendThread(
               AddStream, Cache, Task, BM, CombinedIndex, ImportList, ExportList,
               ResolvedODR, DefinedGlobals, ModuleMap);
+          if (ProfileThread)
+            timeTraceProfilerFinishThread();
           if (E) {
             std::unique_lock<std::mutex> L(ErrMu);
             if (Err)
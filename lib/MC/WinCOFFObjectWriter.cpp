@@ -587,26 +587,49 @@ void WinCOFFObjectWriter::WriteRelocation(const COFF::relocation &R) {
   W.write<uint16_t>(R.Type);
 }
 
+namespace {
+
+// A stream that writes through to the object file and computes the CRC of
+// everything written on the way, so that section contents never have to be
+// held in memory in full.
+class raw_crc_ostream : public raw_ostream {
+  raw_ostream &OS;
+  JamCRC JC;
+  uint64_t Pos = 0;
+
+  void write_impl(const char *Ptr, size_t Size) override {
+    JC.update(makeArrayRef(reinterpret_cast<const uint8_t *>(Ptr), Size));
+    OS.write(Ptr, Size);
+    Pos += Size;
+  }
+
+  uint64_t current_pos() const override { return Pos; }
+
+public:
+  // Calculate our CRC with an initial value of '0', this is not how
+  // JamCRC is specified but it aligns with the expected output.
+  raw_crc_ostream(raw_ostream &OS) : OS(OS), JC(/*Init=*/0) {}
+  ~raw_crc_ostream() override { flush(); }
+
+  uint32_t getCRC() {
+    flush();
+    return JC.getCRC();
+  }
+};
+
+} // end anonymous namespace
+
 // Write MCSec's contents. What this function does is essentially
 // "Asm.writeSectionData(&MCSec, Layout)", but it's a bit complicated
 // because it needs to compute a CRC.
 uint32_t WinCOFFObjectWriter::writeSectionContents(MCAssembler &Asm,
                                                    const MCAsmLayout &Layout,
                                                    const MCSection &MCSec) {
-  // Save the contents of the section to a temporary buffer, we need this
-  // to CRC the data before we dump it into the object file.
-  SmallVector<char, 128> Buf;
-  raw_svector_ostream VecOS(Buf);
-  Asm.writeSectionData(VecOS, &MCSec, Layout);
-
-  // Write the section contents to the object file.
-  W.OS << Buf;
-
-  // Calculate our CRC with an initial value of '0', this is not how
-  // JamCRC is specified but it aligns with the expected output.
-  JamCRC JC(/*Init=*/0);
-  JC.update(makeArrayRef(reinterpret_cast<uint8_t*>(Buf.data()), Buf.size()));
-  return JC.getCRC();
+  // Write the section contents to the object file, computing their CRC as
+  // they are written instead of staging a copy of the section.
+  raw_crc_ostream CRCOS(W.OS);
+  Asm.writeSectionData(CRCOS, &MCSec, Layout);
+  return CRCOS.getCRC();
 }
 
 void WinCOFFObjectWriter::writeSection(MCAssembler &Asm,
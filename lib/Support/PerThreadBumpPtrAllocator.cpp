@@ -0,0 +1,59 @@
+//===- PerThreadBumpPtrAllocator.cpp - Per-thread arenas ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/Compiler.h"
+#include <atomic>
+
+using namespace llvm;
+using namespace llvm::detail;
+
+static std::atomic<uint64_t> NextArenaID{0};
+static std::atomic<uint64_t> NextThreadNumber{0};
+
+/// A number identifying the current thread, assigned on first use. Unlike
+/// thread ids, numbers are not reused when threads exit.
+static LLVM_THREAD_LOCAL uint64_t ThreadNumber = 0;
+
+namespace {
+struct CachedAllocator {
+  uint64_t ArenaID;
+  void *Allocator;
+};
+} // end anonymous namespace
+
+/// The allocators the current thread used last, indexed by arena ID modulo
+/// the number of entries, so that code alternating between a few arenas does
+/// not take their locks on every switch.
+static constexpr unsigned NumCachedAllocators = 8;
+static LLVM_THREAD_LOCAL CachedAllocator Cache[NumCachedAllocators];
+
+PerThreadAllocatorBase::PerThreadAllocatorBase() : ID(++NextArenaID) {}
+
+void *PerThreadAllocatorBase::getThreadLocal(function_ref<void *()> Create) {
+  CachedAllocator &Entry = Cache[ID % NumCachedAllocators];
+  if (Entry.ArenaID == ID)
+    return Entry.Allocator;
+
+  if (!ThreadNumber)
+    ThreadNumber = ++NextThreadNumber;
+
+  std::lock_guard<std::mutex> Guard(Lock);
+  void *&Alloc = Threads[ThreadNumber];
+  if (!Alloc)
+    Alloc = Create();
+  Entry.ArenaID = ID;
+  Entry.Allocator = Alloc;
+  return Alloc;
+}
+
+void PerThreadAllocatorBase::forgetThreads() {
+  // A fresh ID invalidates the entries cached by all threads.
+  ID = ++NextArenaID;
+  Threads.clear();
+}
@@ -14,10 +14,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/SpecialCaseList.h"
+#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Regex.h"
+#include <algorithm>
 #include <string>
 #include <system_error>
 #include <utility>
@@ -25,6 +27,11 @@
 #include <stdio.h>
 namespace llvm {
 
+static void reverse(StringRef Str, SmallVectorImpl<char> &Reversed) {
+  Reversed.assign(Str.begin(), Str.end());
+  std::reverse(Reversed.begin(), Reversed.end());
+}
+
 bool SpecialCaseList::Matcher::insert(std::string Regexp,
                                       unsigned LineNumber,
                                       std::string &REError) {
@@ -37,6 +44,26 @@ bool SpecialCaseList::Matcher::insert(std::string Regexp,
     Strings[Regexp] = LineNumber;
     return true;
   }
+
+  // Match "literal*", "*literal" and "*literal*" without a Regex.
+  StringRef Wildcard(Regexp);
+  if (Wildcard.endswith("*") && Regex::isLiteralERE(Wildcard.drop_back())) {
+    Prefixes.insert(Wildcard.drop_back(), NumWildcards++, LineNumber);
+    return true;
+  }
+  if (Wildcard.startswith("*") && Regex::isLiteralERE(Wildcard.drop_front())) {
+    SmallString<128> Suffix;
+    reverse(Wildcard.drop_front(), Suffix);
+    ReversedSuffixes.insert(Suffix, NumWildcards++, LineNumber);
+    return true;
+  }
+  if (Wildcard.size() > 2 && Wildcard.startswith("*") &&
+      Wildcard.endswith("*") &&
+      Regex::isLiteralERE(Wildcard.drop_front().drop_back())) {
+    Substrings.push_back(
+        {Wildcard.drop_front().drop_back(), NumWildcards++, LineNumber});
+    return true;
+  }
   Trigrams.insert(Regexp);
 
   // Replace * with .*
@@ -54,6 +81,7 @@ bool SpecialCaseList::Matcher::insert(std::string Regexp,
 
   RegExes.emplace_back(
       std::make_pair(std::make_unique<Regex>(std::move(CheckRE)), LineNumber));
+  RegExIndices.push_back(NumWildcards++);
   return true;
 }
 
@@ -61,12 +89,74 @@ unsigned SpecialCaseList::Matcher::match(StringRef Query) const {
   auto It = Strings.find(Query);
   if (It != Strings.end())
     return It->second;
-  if (Trigrams.isDefinitelyOut(Query))
-    return false;
-  for (auto& RegExKV : RegExes)
-    if (RegExKV.first->match(Query))
-      return RegExKV.second;
-  return 0;
+
+  // Return the first inserted wildcard expression that matches.
+  unsigned Index = NumWildcards;
+  unsigned LineNumber = 0;
+  Prefixes.match(Query, Index, LineNumber);
+  if (!ReversedSuffixes.empty()) {
+    SmallString<128> ReversedQuery;
+    reverse(Query, ReversedQuery);
+    ReversedSuffixes.match(ReversedQuery, Index, LineNumber);
+  }
+  for (const Substring &S : Substrings) {
+    if (S.Index >= Index)
+      break;
+    if (Query.find(S.Literal) != StringRef::npos) {
+      Index = S.Index;
+      LineNumber = S.LineNumber;
+      break;
+    }
+  }
+  if (RegExes.empty() || Trigrams.isDefinitelyOut(Query))
+    return LineNumber;
+  for (size_t I = 0, E = RegExes.size(); I != E && RegExIndices[I] < Index;
+       ++I)
+    if (RegExes[I].first->match(Query))
+      return RegExes[I].second;
+  return LineNumber;
+}
+
+void SpecialCaseList::Matcher::PrefixSet::insert(StringRef Prefix,
+                                                 unsigned Index,
+                                                 unsigned LineNumber) {
+  // Indices only grow, so a literal inserted earlier, or a prefix of it,
+  // wins over this one, and the entries of longer literals are unaffected.
+  FirstMatch First = {Index, LineNumber};
+  if (const FirstMatch *Shorter = findLongestPrefix(Prefix))
+    First = *Shorter;
+  Literals.emplace(Prefix, First);
+}
+
+void SpecialCaseList::Matcher::PrefixSet::match(StringRef Query,
+                                                unsigned &Index,
+                                                unsigned &LineNumber) const {
+  const FirstMatch *First = findLongestPrefix(Query);
+  if (First && First->Index < Index) {
+    Index = First->Index;
+    LineNumber = First->LineNumber;
+  }
+}
+
+const SpecialCaseList::Matcher::PrefixSet::FirstMatch *
+SpecialCaseList::Matcher::PrefixSet::findLongestPrefix(StringRef Query) const {
+  // Every literal that is a prefix of Query sorts between that prefix and
+  // Query, so it is also a prefix of the greatest literal not after Query. If
+  // that literal is not a prefix of Query itself, the search continues with
+  // the common prefix of the two, which is shorter than Query.
+  while (true) {
+    auto It = Literals.upper_bound(Query);
+    if (It == Literals.begin())
+      return nullptr;
+    --It;
+    StringRef Literal = It->first;
+    if (Query.startswith(Literal))
+      return &It->second;
+    size_t Common = 0;
+    while (Literal[Common] == Query[Common])
+      ++Common;
+    Query = Query.take_front(Common);
+  }
 }
 
 std::unique_ptr<SpecialCaseList>
@@ -24,86 +24,50 @@ using namespace llvm;
 ThreadPool::ThreadPool() : ThreadPool(hardware_concurrency()) {}
 
 ThreadPool::ThreadPool(unsigned ThreadCount)
-    : ActiveThreads(0), EnableFlag(true) {
-  // Create ThreadCount threads that will loop forever, wait on QueueCondition
-  // for tasks to be queued or the Pool to be destroyed.
-  Threads.reserve(ThreadCount);
-  for (unsigned ThreadID = 0; ThreadID < ThreadCount; ++ThreadID) {
-    Threads.emplace_back([&] {
-      while (true) {
-        PackagedTaskTy Task;
-        {
-          std::unique_lock<std::mutex> LockGuard(QueueLock);
-          // Wait for tasks to be pushed in the queue
-          QueueCondition.wait(LockGuard,
-                              [&] { return !EnableFlag || !Tasks.empty(); });
-          // Exit condition
-          if (!EnableFlag && Tasks.empty())
-            return;
-          // Yeah, we have a task, grab it and release the lock on the queue
-
-          // We first need to signal that we are active before popping the queue
-          // in order for wait() to properly detect that even if the queue is
-          // empty, there is still a task in flight.
-          {
-            std::unique_lock<std::mutex> LockGuard(CompletionLock);
-            ++ActiveThreads;
-          }
-          Task = std::move(Tasks.front());
-          Tasks.pop();
-        }
-        // Run the task we just grabbed
-        Task();
-
-        {
-          // Adjust `ActiveThreads`, in case someone waits on ThreadPool::wait()
-          std::unique_lock<std::mutex> LockGuard(CompletionLock);
-          --ActiveThreads;
-        }
-
-        // Notify task completion, in case someone waits on ThreadPool::wait()
-        CompletionCondition.notify_all();
-      }
-    });
-  }
-}
+    : Executor(std::make_unique<WorkStealingExecutor>(ThreadCount)),
+      OutstandingTasks(0), EnableFlag(true) {}
 
 void ThreadPool::wait() {
-  // Wait for all threads to complete and the queue to be empty
+  // A task waiting for its own pool to go idle would wait for itself.
+  assert(!Executor->isWorkerThread() && "ThreadPool::wait() called from a task");
+
+  // Wait for all tasks to complete
   std::unique_lock<std::mutex> LockGuard(CompletionLock);
-  // The order of the checks for ActiveThreads and Tasks.empty() matters because
-  // any active threads might be modifying the Tasks queue, and this would be a
-  // race.
-  CompletionCondition.wait(LockGuard,
-                           [&] { return !ActiveThreads && Tasks.empty(); });
+  CompletionCondition.wait(LockGuard, [&] { return !OutstandingTasks; });
 }
 
 std::shared_future<void> ThreadPool::asyncImpl(TaskTy Task) {
-  /// Wrap the Task in a packaged_task to return a future object.
-  PackagedTaskTy PackagedTask(std::move(Task));
-  auto Future = PackagedTask.get_future();
-  {
-    // Lock the queue and push the new task
-    std::unique_lock<std::mutex> LockGuard(QueueLock);
-
-    // Don't allow enqueueing after disabling the pool
-    assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
+  // Don't allow enqueueing after disabling the pool
+  assert(EnableFlag && "Queuing a thread during ThreadPool destruction");
 
-    Tasks.push(std::move(PackagedTask));
-  }
-  QueueCondition.notify_one();
+  /// Wrap the Task in a packaged_task to return a future object.
+  auto PackagedTask = std::make_shared<PackagedTaskTy>(std::move(Task));
+  auto Future = PackagedTask->get_future();
+
+  // Count the task before it becomes visible to the workers so that wait()
+  // cannot observe an idle pool while it is in flight.
+  ++OutstandingTasks;
+  Executor->add([this, PackagedTask] {
+    // Run the task we just grabbed
+    (*PackagedTask)();
+
+    {
+      // Adjust `OutstandingTasks`, in case someone waits on ThreadPool::wait()
+      std::unique_lock<std::mutex> LockGuard(CompletionLock);
+      --OutstandingTasks;
+    }
+
+    // Notify task completion, in case someone waits on ThreadPool::wait()
+    CompletionCondition.notify_all();
+  });
   return Future.share();
 }
 
 // The destructor joins all threads, waiting for completion.
 ThreadPool::~ThreadPool() {
-  {
-    std::unique_lock<std::mutex> LockGuard(QueueLock);
-    EnableFlag = false;
-  }
-  QueueCondition.notify_all();
-  for (auto &Worker : Threads)
-    Worker.join();
+  wait();
+  EnableFlag = false;
+  Executor.reset();
 }
 
 #else // LLVM_ENABLE_THREADS Disabled
@@ -111,8 +75,7 @@ ThreadPool::~ThreadPool() {
 ThreadPool::ThreadPool() : ThreadPool(0) {}
 
 // No threads are launched, issue a warning if ThreadCount is not 0
-ThreadPool::ThreadPool(unsigned ThreadCount)
-    : ActiveThreads(0) {
+ThreadPool::ThreadPool(unsigned ThreadCount) {
   if (ThreadCount) {
     errs() << "Warning: request a ThreadPool with " << ThreadCount
            << " threads, but LLVM_ENABLE_THREADS has been turned off\n";
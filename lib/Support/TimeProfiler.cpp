@@ -15,8 +15,11 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -24,7 +27,21 @@ using namespace std::chrono;
 
 namespace llvm {
 
-TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
+LLVM_THREAD_LOCAL TimeTraceProfiler *TimeTraceProfilerInstance = nullptr;
+
+namespace {
+/// The profilers of worker threads that called
+/// timeTraceProfilerFinishThread(), to be written by the main thread.
+struct TimeTraceProfilerInstances {
+  std::mutex Lock;
+  std::vector<TimeTraceProfiler *> List;
+};
+
+TimeTraceProfilerInstances &getTimeTraceProfilerInstances() {
+  static TimeTraceProfilerInstances Instances;
+  return Instances;
+}
+} // end anonymous namespace
 
 typedef duration<steady_clock::rep, steady_clock::period> DurationType;
 typedef time_point<steady_clock> TimePointType;
@@ -59,8 +76,13 @@ struct Entry {
 };
 
 struct TimeTraceProfiler {
-  TimeTraceProfiler() {
-    StartTime = steady_clock::now();
+  TimeTraceProfiler(unsigned TimeTraceGranularity, StringRef ProcName)
+      : StartTime(steady_clock::now()), ProcName(ProcName),
+        Tid(llvm::get_threadid()),
+        TimeTraceGranularity(TimeTraceGranularity) {
+    SmallString<64> Name;
+    llvm::get_thread_name(Name);
+    ThreadName = Name.str();
   }
 
   void begin(std::string Name, llvm::function_ref<std::string()> Detail) {
@@ -106,33 +128,71 @@ struct TimeTraceProfiler {
   void Write(raw_pwrite_stream &OS) {
     assert(Stack.empty() &&
            "All profiler sections should be ended when calling Write");
+    auto &Instances = getTimeTraceProfilerInstances();
+    std::lock_guard<std::mutex> Lock(Instances.Lock);
+    assert(llvm::all_of(Instances.List,
+                        [](const TimeTraceProfiler *TTP) {
+                          return TTP->Stack.empty();
+                        }) &&
+           "All profiler sections should be ended when calling Write");
+
+    // The calling thread gets track 0, the other threads the following ones,
+    // in the order they finished their first task. A thread that profiled
+    // several tasks keeps a single track.
+    SmallVector<const TimeTraceProfiler *, 8> Profilers;
+    Profilers.push_back(this);
+    Profilers.append(Instances.List.begin(), Instances.List.end());
+    SmallVector<const TimeTraceProfiler *, 8> Tracks;
+    auto getTrack = [&](const TimeTraceProfiler &TTP) -> int64_t {
+      auto It = llvm::find_if(Tracks, [&](const TimeTraceProfiler *Track) {
+        return Track->Tid == TTP.Tid;
+      });
+      if (It == Tracks.end())
+        It = Tracks.insert(Tracks.end(), &TTP);
+      return It - Tracks.begin();
+    };
+
     json::OStream J(OS);
     J.objectBegin();
     J.attributeBegin("traceEvents");
     J.arrayBegin();
 
-    // Emit all events for the main flame graph.
-    for (const auto &E : Entries) {
-      auto StartUs = E.getFlameGraphStartUs(StartTime);
-      auto DurUs = E.getFlameGraphDurUs();
+    // Emit all events for the main flame graph. Events of all threads are
+    // relative to the start of the writing profiler.
+    for (const TimeTraceProfiler *TTP : Profilers) {
+      int64_t Track = getTrack(*TTP);
+      for (const auto &E : TTP->Entries) {
+        auto StartUs = E.getFlameGraphStartUs(StartTime);
+        auto DurUs = E.getFlameGraphDurUs();
+
+        J.object([&]{
+          J.attribute("pid", 1);
+          J.attribute("tid", Track);
+          J.attribute("ph", "X");
+          J.attribute("ts", StartUs);
+          J.attribute("dur", DurUs);
+          J.attribute("name", E.Name);
+          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        });
+      }
+    }
 
-      J.object([&]{
-        J.attribute("pid", 1);
-        J.attribute("tid", 0);
-        J.attribute("ph", "X");
-        J.attribute("ts", StartUs);
-        J.attribute("dur", DurUs);
-        J.attribute("name", E.Name);
-        J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
-      });
+    // Combine the totals of all threads.
+    StringMap<CountAndDurationType> AllCountAndTotalPerName;
+    for (const TimeTraceProfiler *TTP : Profilers) {
+      for (const auto &E : TTP->CountAndTotalPerName) {
+        auto &CountAndTotal = AllCountAndTotalPerName[E.getKey()];
+        CountAndTotal.first += E.getValue().first;
+        CountAndTotal.second += E.getValue().second;
+      }
     }
 
     // Emit totals by section name as additional "thread" events, sorted from
     // longest one.
-    int Tid = 1;
+    int64_t TotalTid = Tracks.size();
     std::vector<NameAndCountAndDurationType> SortedTotals;
-    SortedTotals.reserve(CountAndTotalPerName.size());
-    for (const auto &E : CountAndTotalPerName)
+    SortedTotals.reserve(AllCountAndTotalPerName.size());
+    for (const auto &E : AllCountAndTotalPerName)
       SortedTotals.emplace_back(E.getKey(), E.getValue());
 
     llvm::sort(SortedTotals.begin(), SortedTotals.end(),
@@ -142,11 +202,11 @@ struct TimeTraceProfiler {
                });
     for (const auto &E : SortedTotals) {
       auto DurUs = duration_cast<microseconds>(E.second.second).count();
-      auto Count = CountAndTotalPerName[E.first].first;
+      auto Count = AllCountAndTotalPerName[E.first].first;
 
       J.object([&]{
         J.attribute("pid", 1);
-        J.attribute("tid", Tid);
+        J.attribute("tid", TotalTid);
         J.attribute("ph", "X");
         J.attribute("ts", 0);
         J.attribute("dur", DurUs);
@@ -157,7 +217,7 @@ struct TimeTraceProfiler {
         });
       });
 
-      ++Tid;
+      ++TotalTid;
     }
 
     // Emit metadata event with process name.
@@ -168,9 +228,26 @@ struct TimeTraceProfiler {
       J.attribute("ts", 0);
       J.attribute("ph", "M");
       J.attribute("name", "process_name");
-      J.attributeObject("args", [&] { J.attribute("name", "clang"); });
+      J.attributeObject("args", [&] { J.attribute("name", ProcName); });
     });
 
+    // Name the tracks of the worker threads.
+    for (int64_t Track = 1, E = Tracks.size(); Track != E; ++Track) {
+      const std::string &Name = Tracks[Track]->ThreadName;
+      J.object([&] {
+        J.attribute("cat", "");
+        J.attribute("pid", 1);
+        J.attribute("tid", Track);
+        J.attribute("ts", 0);
+        J.attribute("ph", "M");
+        J.attribute("name", "thread_name");
+        J.attributeObject("args", [&] {
+          J.attribute("name",
+                      Name.empty() ? "thread " + std::to_string(Track) : Name);
+        });
+      });
+    }
+
     J.arrayEnd();
     J.attributeEnd();
     J.objectEnd();
@@ -179,22 +256,40 @@ struct TimeTraceProfiler {
   SmallVector<Entry, 16> Stack;
   SmallVector<Entry, 128> Entries;
   StringMap<CountAndDurationType> CountAndTotalPerName;
-  TimePointType StartTime;
+  const TimePointType StartTime;
+  const std::string ProcName;
+  const uint64_t Tid;
+  std::string ThreadName;
 
   // Minimum time granularity (in microseconds)
-  unsigned TimeTraceGranularity;
+  const unsigned TimeTraceGranularity;
 };
 
-void timeTraceProfilerInitialize(unsigned TimeTraceGranularity) {
+void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
+                                 StringRef ProcName) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
-  TimeTraceProfilerInstance = new TimeTraceProfiler();
-  TimeTraceProfilerInstance->TimeTraceGranularity = TimeTraceGranularity;
+  TimeTraceProfilerInstance =
+      new TimeTraceProfiler(TimeTraceGranularity, ProcName);
 }
 
 void timeTraceProfilerCleanup() {
   delete TimeTraceProfilerInstance;
   TimeTraceProfilerInstance = nullptr;
+  auto &Instances = getTimeTraceProfilerInstances();
+  std::lock_guard<std::mutex> Lock(Instances.Lock);
+  for (TimeTraceProfiler *TTP : Instances.List)
+    delete TTP;
+  Instances.List.clear();
+}
+
+void timeTraceProfilerFinishThread() {
+  assert(TimeTraceProfilerInstance != nullptr &&
+         "Profiler object can't be null");
+  auto &Instances = getTimeTraceProfilerInstances();
+  std::lock_guard<std::mutex> Lock(Instances.Lock);
+  Instances.List.push_back(TimeTraceProfilerInstance);
+  TimeTraceProfilerInstance = nullptr;
 }
 
 void timeTraceProfilerWrite(raw_pwrite_stream &OS) {
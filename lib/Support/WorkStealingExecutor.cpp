@@ -0,0 +1,174 @@
+//===-- llvm/Support/WorkStealingExecutor.cpp - Work-stealing tasks -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the work-stealing executor shared by ThreadPool and
+// the parallel algorithms.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/WorkStealingExecutor.h"
+
+#if LLVM_ENABLE_THREADS
+
+#include "llvm/Support/Compiler.h"
+#include "llvm/Support/ManagedStatic.h"
+
+using namespace llvm;
+
+/// The executor the current thread is a worker of, if any, and the index of
+/// the worker's own deque.
+static LLVM_THREAD_LOCAL WorkStealingExecutor *CurrentExecutor = nullptr;
+static LLVM_THREAD_LOCAL unsigned CurrentQueue = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(unsigned ThreadCount) {
+  // The queues must all exist before the first worker starts stealing.
+  Queues.reserve(ThreadCount + 1);
+  for (unsigned I = 0; I <= ThreadCount; ++I)
+    Queues.push_back(std::make_unique<WorkQueue>());
+
+  Threads.reserve(ThreadCount);
+  for (unsigned I = 0; I < ThreadCount; ++I)
+    Threads.emplace_back([this, I] { work(I); });
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> Lock(SleepLock);
+    Stop = true;
+  }
+  WorkerCondition.notify_all();
+  for (auto &Worker : Threads)
+    Worker.join();
+}
+
+bool WorkStealingExecutor::isWorkerThread() const {
+  return CurrentExecutor == this;
+}
+
+void WorkStealingExecutor::add(TaskTy F) {
+  // Workers push onto their own deque, everybody else onto the injection
+  // queue, which is the last one.
+  WorkQueue &Q = *Queues[isWorkerThread() ? CurrentQueue : Queues.size() - 1];
+  {
+    std::lock_guard<std::mutex> Lock(Q.Lock);
+    Q.Tasks.push_back(std::move(F));
+    // Counting under the queue lock guarantees that Pending never drops below
+    // the number of tasks actually queued.
+    ++Pending;
+  }
+
+  // Both the increment of Pending above and the increment of the sleeper
+  // counts in work() and helpUntil() are sequentially consistent, so either
+  // we see the sleeper here or the sleeper sees the new task before blocking.
+  if (SleepingWorkers || SleepingHelpers) {
+    std::lock_guard<std::mutex> Lock(SleepLock);
+    WorkerCondition.notify_one();
+    HelperCondition.notify_all();
+  }
+}
+
+bool WorkStealingExecutor::popTask(unsigned Self, TaskTy &Task) {
+  if (!Pending)
+    return false;
+
+  // Take the most recently pushed task from our own deque first.
+  unsigned NumQueues = Queues.size();
+  bool IsWorker = Self != NumQueues - 1;
+  if (IsWorker) {
+    WorkQueue &Q = *Queues[Self];
+    std::lock_guard<std::mutex> Lock(Q.Lock);
+    if (!Q.Tasks.empty()) {
+      Task = std::move(Q.Tasks.back());
+      Q.Tasks.pop_back();
+      --Pending;
+      return true;
+    }
+  }
+
+  // Otherwise steal the oldest task of some other queue, starting with our
+  // neighbour so that thieves spread out over the victims. Threads outside
+  // the executor start with the injection queue.
+  for (unsigned I = IsWorker ? 1 : 0; I < NumQueues; ++I) {
+    WorkQueue &Q = *Queues[(Self + I) % NumQueues];
+    std::lock_guard<std::mutex> Lock(Q.Lock);
+    if (!Q.Tasks.empty()) {
+      Task = std::move(Q.Tasks.front());
+      Q.Tasks.pop_front();
+      --Pending;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::runTask(TaskTy &Task) {
+  Task();
+
+  // The task may have satisfied the condition a helper is waiting for. The
+  // fence pairs with the one in helpUntil(): either the helper sees the
+  // effects of the task, or we see the helper.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (SleepingHelpers) {
+    std::lock_guard<std::mutex> Lock(SleepLock);
+    HelperCondition.notify_all();
+  }
+}
+
+bool WorkStealingExecutor::runOneTask() {
+  TaskTy Task;
+  if (!popTask(isWorkerThread() ? CurrentQueue : Queues.size() - 1, Task))
+    return false;
+  runTask(Task);
+  return true;
+}
+
+void WorkStealingExecutor::helpUntil(function_ref<bool()> Done) {
+  unsigned Self = isWorkerThread() ? CurrentQueue : Queues.size() - 1;
+  while (!Done()) {
+    TaskTy Task;
+    if (popTask(Self, Task)) {
+      runTask(Task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> Lock(SleepLock);
+    ++SleepingHelpers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    HelperCondition.wait(Lock, [&] { return Pending || Done(); });
+    --SleepingHelpers;
+  }
+}
+
+void WorkStealingExecutor::work(unsigned Index) {
+  CurrentExecutor = this;
+  CurrentQueue = Index;
+  while (true) {
+    TaskTy Task;
+    if (popTask(Index, Task)) {
+      runTask(Task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> Lock(SleepLock);
+    ++SleepingWorkers;
+    WorkerCondition.wait(Lock, [&] { return Stop || Pending; });
+    --SleepingWorkers;
+    // Exit condition: the queues are drained and the executor is going away.
+    if (Stop && !Pending)
+      break;
+  }
+  CurrentExecutor = nullptr;
+}
+
+static ManagedStatic<WorkStealingExecutor> DefaultExecutor;
+
+WorkStealingExecutor &WorkStealingExecutor::getDefault() {
+  return *DefaultExecutor;
+}
+
+#endif // LLVM_ENABLE_THREADS
@@ -0,0 +1,31 @@
+; RUN: opt < %s -passes='print<known-bits>' -disable-output 2>&1 | FileCheck %s
+
+; CHECK-LABEL: Known bits for function: simple
+; CHECK-NEXT: %x: zero=0x0 one=0x0 signbits=1 maybezero
+; CHECK-NEXT: %p: zero=0x0 one=0x0 nonzero
+; CHECK-NEXT: %and: zero=0xF0 one=0x0 signbits=4 maybezero
+; CHECK-NEXT: %or: zero=0xE0 one=0x10 signbits=3 nonzero
+; CHECK-NEXT: %ashr: zero=0x0 one=0x0 signbits=5 maybezero
+; CHECK-NEXT: %gep: zero=0x0 one=0x0 maybezero
+define i8 @simple(i8 %x, i8* nonnull %p) {
+  %and = and i8 %x, 15
+  %or = or i8 %and, 16
+  %ashr = ashr i8 %x, 4
+  %gep = getelementptr i8, i8* %p, i64 1
+  store i8 %ashr, i8* %gep
+  ret i8 %or
+}
+
+; The assumption is taken into account for the values it dominates.
+; CHECK-LABEL: Known bits for function: assume
+; CHECK-NEXT: %x: zero=0x0 one=0x0 signbits=1 maybezero
+; CHECK-NEXT: %cmp: zero=0x0 one=0x0 signbits=1 maybezero
+; CHECK-NEXT: %add: zero=0xFFFFFF00 one=0x0 signbits=24 maybezero
+define i32 @assume(i32 %x) {
+  %cmp = icmp ult i32 %x, 128
+  call void @llvm.assume(i1 %cmp)
+  %add = add i32 %x, %x
+  ret i32 %add
+}
+
+declare void @llvm.assume(i1)
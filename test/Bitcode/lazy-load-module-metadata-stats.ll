@@ -0,0 +1,24 @@
+; Check that -force-ondemand-mds-loading really reads the module-level
+; metadata through the metadata index, rather than parsing the whole block up
+; front as without it. lazy-load-module-metadata.ll checks that both ways
+; yield the same module.
+; REQUIRES: asserts
+
+; RUN: llvm-as < %S/lazy-load-module-metadata.ll -bitcode-mdindex-threshold=0 \
+; RUN:   -o %t.bc
+; RUN: llvm-dis < %t.bc -o /dev/null -stats 2> %t.eager
+; RUN: llvm-dis < %t.bc -o /dev/null -force-ondemand-mds-loading -stats \
+; RUN:   2> %t.lazy
+; RUN: cat %t.eager %t.lazy | FileCheck %s
+
+; Parsing the whole block needs no forward references.
+; CHECK-NOT: Number of MDNode::Temporary created
+; CHECK: [[#RECORDS:]] bitcode-reader - Number of Metadata records loaded
+; CHECK: [[#STRINGS:]] bitcode-reader - Number of MDStrings loaded
+
+; Loading on demand resolves forward references through temporaries, loads a
+; different number of records, and the same strings.
+; CHECK: Number of MDNode::Temporary created
+; CHECK-NOT: [[#RECORDS]] bitcode-reader - Number of Metadata records loaded
+; CHECK: bitcode-reader - Number of Metadata records loaded
+; CHECK: [[#STRINGS]] bitcode-reader - Number of MDStrings loaded
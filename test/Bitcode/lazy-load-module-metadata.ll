@@ -0,0 +1,50 @@
+; RUN: llvm-as < %s -bitcode-mdindex-threshold=0 -o %t.bc
+; RUN: llvm-dis < %t.bc | FileCheck %s
+; RUN: llvm-dis < %t.bc -force-ondemand-mds-loading | FileCheck %s
+; Check that loading module-level metadata on demand through the metadata
+; index yields the same module as parsing the whole block up front.
+
+; CHECK: @g = global i32 0, !dbg ![[GVE:[0-9]+]]
+@g = global i32 0, !dbg !0
+
+; CHECK: define void @f() !dbg ![[SP:[0-9]+]] {
+; CHECK-NEXT: ret void, !dbg ![[LOC:[0-9]+]], !attached ![[ATT:[0-9]+]]
+define void @f() !dbg !8 {
+  ret void, !dbg !11, !attached !12
+}
+
+; CHECK: !llvm.dbg.cu = !{![[CU:[0-9]+]]}
+; CHECK: !llvm.module.flags = !{![[FLAG:[0-9]+]]}
+; CHECK: !named = !{![[NAMED:[0-9]+]]}
+!llvm.dbg.cu = !{!2}
+!llvm.module.flags = !{!7}
+!named = !{!13}
+
+; CHECK-DAG: ![[GVE]] = !DIGlobalVariableExpression(var: ![[GV:[0-9]+]], expr: !DIExpression())
+; CHECK-DAG: ![[GV]] = distinct !DIGlobalVariable(name: "g", scope: ![[CU]], file: ![[FILE:[0-9]+]], line: 1, type: ![[INT:[0-9]+]], isLocal: false, isDefinition: true)
+; CHECK-DAG: ![[CU]] = distinct !DICompileUnit(language: DW_LANG_C99, file: ![[FILE]], producer: "clang", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug, enums: ![[EMPTY:[0-9]+]], globals: ![[GLOBALS:[0-9]+]])
+; CHECK-DAG: ![[FILE]] = !DIFile(filename: "t.c", directory: "/")
+; CHECK-DAG: ![[EMPTY]] = !{}
+; CHECK-DAG: ![[GLOBALS]] = !{![[GVE]]}
+; CHECK-DAG: ![[INT]] = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+; CHECK-DAG: ![[FLAG]] = !{i32 2, !"Debug Info Version", i32 3}
+; CHECK-DAG: ![[SP]] = distinct !DISubprogram(name: "f", scope: ![[FILE]], file: ![[FILE]], line: 2, type: ![[SPTY:[0-9]+]], scopeLine: 2, spFlags: DISPFlagDefinition, unit: ![[CU]], retainedNodes: ![[EMPTY]])
+; CHECK-DAG: ![[SPTY]] = !DISubroutineType(types: ![[TYPES:[0-9]+]])
+; CHECK-DAG: ![[TYPES]] = !{null}
+; CHECK-DAG: ![[LOC]] = !DILocation(line: 3, column: 1, scope: ![[SP]])
+; CHECK-DAG: ![[ATT]] = !{!"attached"}
+; CHECK-DAG: ![[NAMED]] = !{![[ATT]], ![[INT]]}
+!0 = !DIGlobalVariableExpression(var: !1, expr: !DIExpression())
+!1 = distinct !DIGlobalVariable(name: "g", scope: !2, file: !3, line: 1, type: !6, isLocal: false, isDefinition: true)
+!2 = distinct !DICompileUnit(language: DW_LANG_C99, file: !3, producer: "clang", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug, enums: !4, globals: !5)
+!3 = !DIFile(filename: "t.c", directory: "/")
+!4 = !{}
+!5 = !{!0}
+!6 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!7 = !{i32 2, !"Debug Info Version", i32 3}
+!8 = distinct !DISubprogram(name: "f", scope: !3, file: !3, line: 2, type: !9, scopeLine: 2, spFlags: DISPFlagDefinition, unit: !2, retainedNodes: !4)
+!9 = !DISubroutineType(types: !10)
+!10 = !{null}
+!11 = !DILocation(line: 3, column: 1, scope: !8)
+!12 = !{!"attached"}
+!13 = !{!12, !6}
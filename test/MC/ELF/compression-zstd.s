@@ -0,0 +1,23 @@
+// REQUIRES: zstd
+// RUN: llvm-mc -filetype=obj -compress-debug-sections=zstd -triple x86_64-pc-linux-gnu < %s -o %t
+// RUN: llvm-readobj --sections %t | FileCheck --check-prefix=FLAGS %s
+// RUN: llvm-objdump -s --section=.debug_str %t | FileCheck --check-prefix=CHDR %s
+// RUN: llvm-dwarfdump -debug-str %t | FileCheck --check-prefix=STR %s
+
+// FLAGS:      Name: .debug_str
+// FLAGS-NEXT: Type: SHT_PROGBITS
+// FLAGS-NEXT: Flags [
+// FLAGS-NEXT:   SHF_COMPRESSED
+// FLAGS-NEXT:   SHF_MERGE
+// FLAGS-NEXT:   SHF_STRINGS
+// FLAGS-NEXT: ]
+
+// The compression header has ch_type ELFCOMPRESS_ZSTD.
+// CHDR:      Contents of section .debug_str:
+// CHDR-NEXT: 0000 02000000 00000000
+
+// Decompressing the section gives back the string.
+// STR: perfectly compressable data sample *****************************************
+
+	.section        .debug_str,"MS",@progbits,1
+        .asciz  "perfectly compressable data sample *****************************************"
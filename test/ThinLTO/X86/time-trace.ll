@@ -0,0 +1,28 @@
+; Check that the ThinLTO backend threads record time trace events, and that
+; they are written as separate tracks of the trace of llvm-lto2.
+
+; REQUIRES: thread_support
+
+; RUN: opt -module-summary %s -o %t1.bc
+; RUN: opt -module-summary %p/Inputs/funcimport2.ll -o %t2.bc
+
+; RUN: llvm-lto2 run %t1.bc %t2.bc -o %t.o -thinlto-threads=2 \
+; RUN:     -time-trace -time-trace-granularity=0 \
+; RUN:     -time-trace-file=%t.json \
+; RUN:     -r=%t1.bc,_foo,plx \
+; RUN:     -r=%t2.bc,_main,plx \
+; RUN:     -r=%t2.bc,_foo,l
+; RUN: FileCheck %s < %t.json
+
+; CHECK-DAG: "name":"ThinLTO backend","args":{"detail":"{{[^"]*}}1.bc"}
+; CHECK-DAG: "name":"ThinLTO backend","args":{"detail":"{{[^"]*}}2.bc"}
+; CHECK-DAG: "name":"process_name","args":{"name":"llvm-lto2"}
+; CHECK-DAG: "tid":1,"ts":0,"ph":"M","name":"thread_name"
+
+target datalayout = "e-m:o-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-apple-macosx10.11.0"
+
+define void @foo() {
+entry:
+  ret void
+}
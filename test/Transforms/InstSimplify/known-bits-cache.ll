@@ -0,0 +1,20 @@
+; RUN: opt < %s -S -debug-pass-manager 2>&1 \
+; RUN:   -passes='require<known-bits>,instsimplify,instsimplify' | FileCheck %s
+
+; Check that instsimplify folds with the known bits cached by an earlier pass,
+; and keeps them cached for later passes when it changes the function.
+
+; CHECK: Running analysis: KnownBitsAnalysis on test
+; CHECK: Running pass: InstSimplifyPass on test
+; CHECK-NOT: Invalidating analysis: KnownBitsAnalysis on test
+; CHECK-NOT: Running analysis: KnownBitsAnalysis on test
+; CHECK: Running pass: InstSimplifyPass on test
+; CHECK-NOT: Running analysis: KnownBitsAnalysis on test
+
+; CHECK-LABEL: define i1 @test(
+; CHECK-NEXT: ret i1 true
+define i1 @test(i8 %x) {
+  %a = or i8 %x, 1
+  %b = trunc i8 %a to i1
+  ret i1 %b
+}
@@ -2659,7 +2659,9 @@ bool DwarfLinker::link(const DebugMap &Map) {
 
     for (const auto &CU : LinkContext.DwarfContext->compile_units()) {
       updateDwarfVersion(CU->getVersion());
-      auto CUDie = CU->getUnitDIE(false);
+      // Only the unit DIE is needed to find module references. The remaining
+      // DIEs are extracted right before the analysis of this object.
+      auto CUDie = CU->getUnitDIE(true);
       if (Options.Verbose) {
         outs() << "Input compilation unit:";
         DIDumpOptions DumpOpts;
@@ -2692,11 +2694,38 @@ bool DwarfLinker::link(const DebugMap &Map) {
   std::condition_variable ProcessedFilesConditionVariable;
   BitVector ProcessedFiles(NumObjects, false);
 
+  // Extracting the DIEs of an object file only touches that object's
+  // DWARFContext, so with more than two threads it is done for all objects
+  // in parallel, ahead of the analysis below. The analysis and cloning of an
+  // object depend on the ODR context and string pools built by the objects
+  // before it and stay serial.
+  auto ExtractLambda = [&](size_t i) {
+    auto &LinkContext = ObjectContexts[i];
+    if (!LinkContext.ObjectFile || !LinkContext.DwarfContext)
+      return;
+    for (const auto &CU : LinkContext.DwarfContext->compile_units())
+      CU->getUnitDIE(false);
+  };
+
+  std::unique_ptr<ThreadPool> ExtractPool;
+  std::vector<std::shared_future<void>> ExtractedObjects;
+  if (Options.Threads > 2) {
+    ExtractPool = std::make_unique<ThreadPool>(Options.Threads - 2);
+    ExtractedObjects.reserve(NumObjects);
+    for (unsigned i = 0, e = NumObjects; i != e; ++i)
+      ExtractedObjects.push_back(ExtractPool->async(ExtractLambda, i));
+  }
+
   //  Analyzing the context info is particularly expensive so it is executed in
   //  parallel with emitting the previous compile unit.
   auto AnalyzeLambda = [&](size_t i) {
     auto &LinkContext = ObjectContexts[i];
 
+    if (!ExtractedObjects.empty())
+      ExtractedObjects[i].wait();
+    else
+      ExtractLambda(i);
+
     if (!LinkContext.ObjectFile || !LinkContext.DwarfContext)
       return;
 
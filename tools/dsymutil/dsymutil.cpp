@@ -528,6 +528,11 @@ int main(int argc, char **argv) {
         std::min<unsigned>(Options.LinkOpts.Threads, DebugMapPtrsOrErr->size());
     ThreadPool Threads(ThreadCount);
 
+    // The links of the architectures run concurrently, so each gets its share
+    // of the threads rather than all of them.
+    Options.LinkOpts.Threads =
+        std::max(1u, Options.LinkOpts.Threads / ThreadCount);
+
     // If there is more than one link to execute, we need to generate
     // temporary files.
     const bool NeedsTempFiles =
@@ -25,6 +25,7 @@
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
 
 using namespace llvm;
 using namespace lto;
@@ -137,6 +138,21 @@ static cl::opt<bool>
 static cl::opt<std::string>
     StatsFile("stats-file", cl::desc("Filename to write statistics to"));
 
+static cl::opt<bool> TimeTrace("time-trace",
+                               cl::desc("Record time trace events, including "
+                                        "those of the ThinLTO backend threads"));
+
+static cl::opt<unsigned> TimeTraceGranularity(
+    "time-trace-granularity",
+    cl::desc("Minimum time granularity (in microseconds) traced by the time "
+             "profiler"),
+    cl::init(500));
+
+static cl::opt<std::string>
+    TimeTraceFile("time-trace-file",
+                  cl::desc("Filename to write the time trace to (default: "
+                           "<output>.time-trace.json)"));
+
 static void check(Error E, std::string Msg) {
   if (!E)
     return;
@@ -270,6 +286,8 @@ static int run(int argc, char **argv) {
   Conf.OverrideTriple = OverrideTriple;
   Conf.DefaultTriple = DefaultTriple;
   Conf.StatsFile = StatsFile;
+  Conf.TimeTraceEnabled = TimeTrace;
+  Conf.TimeTraceGranularity = TimeTraceGranularity;
 
   ThinBackend Backend;
   if (ThinLTODistributedIndexes)
@@ -346,7 +364,21 @@ static int run(int argc, char **argv) {
   if (!CacheDir.empty())
     Cache = check(localCache(CacheDir, AddBuffer), "failed to create cache");
 
+  if (TimeTrace)
+    timeTraceProfilerInitialize(TimeTraceGranularity, "llvm-lto2");
+
   check(Lto.run(AddStream, Cache), "LTO::run failed");
+
+  if (TimeTrace) {
+    std::string Path = TimeTraceFile.empty()
+                           ? OutputFilename + ".time-trace.json"
+                           : std::string(TimeTraceFile);
+    std::error_code EC;
+    raw_fd_ostream OS(Path, EC, sys::fs::OF_Text);
+    check(EC, Path);
+    timeTraceProfilerWrite(OS);
+    timeTraceProfilerCleanup();
+  }
   return 0;
 }
 
@@ -430,9 +430,23 @@ void ELFSectionWriter<ELFT>::visit(const DecompressedSection &Sec) {
       reinterpret_cast<const char *>(Sec.OriginalData.data()) + DataOffset,
       Sec.OriginalData.size() - DataOffset);
 
+  const bool IsZstd =
+      !isDataGnuCompressed(Sec.OriginalData) &&
+      reinterpret_cast<const Elf_Chdr_Impl<ELFT> *>(Sec.OriginalData.data())
+              ->ch_type == ELF::ELFCOMPRESS_ZSTD;
+  if (IsZstd && !zstd::isAvailable())
+    reportError(Sec.Name,
+                createStringError(errc::invalid_argument,
+                                  "LLVM was not compiled with "
+                                  "LLVM_ENABLE_ZSTD: cannot decompress"));
+
   SmallVector<char, 128> DecompressedContent;
-  if (Error E = zlib::uncompress(CompressedContent, DecompressedContent,
-                                 static_cast<size_t>(Sec.Size)))
+  if (Error E = IsZstd ? zstd::uncompress(CompressedContent,
+                                          DecompressedContent,
+                                          static_cast<size_t>(Sec.Size))
+                       : zlib::uncompress(CompressedContent,
+                                          DecompressedContent,
+                                          static_cast<size_t>(Sec.Size)))
     reportError(Sec.Name, std::move(E));
 
   uint8_t *Buf = Out.getBufferStart() + Sec.Offset;
@@ -490,7 +504,9 @@ void ELFSectionWriter<ELFT>::visit(const CompressedSection &Sec) {
     Buf += sizeof(DecompressedSize);
   } else {
     Elf_Chdr_Impl<ELFT> Chdr;
-    Chdr.ch_type = ELF::ELFCOMPRESS_ZLIB;
+    Chdr.ch_type = Sec.CompressionType == DebugCompressionType::Zstd
+                       ? ELF::ELFCOMPRESS_ZSTD
+                       : ELF::ELFCOMPRESS_ZLIB;
     Chdr.ch_size = Sec.DecompressedSize;
     Chdr.ch_addralign = Sec.DecompressedAlign;
     memcpy(Buf, &Chdr, sizeof(Chdr));
@@ -504,10 +520,11 @@ CompressedSection::CompressedSection(const SectionBase &Sec,
                                      DebugCompressionType CompressionType)
     : SectionBase(Sec), CompressionType(CompressionType),
       DecompressedSize(Sec.OriginalData.size()), DecompressedAlign(Sec.Align) {
-  if (Error E = zlib::compress(
-          StringRef(reinterpret_cast<const char *>(OriginalData.data()),
-                    OriginalData.size()),
-          CompressedData))
+  StringRef Data(reinterpret_cast<const char *>(OriginalData.data()),
+                 OriginalData.size());
+  if (Error E = CompressionType == DebugCompressionType::Zstd
+                    ? zstd::compress(Data, CompressedData)
+                    : zlib::compress(Data, CompressedData))
     reportError(Name, std::move(E));
 
   size_t ChdrSize;
@@ -220,9 +220,11 @@ static void overlapInput(const std::string &BaseFilename,
   }
 }
 
-/// Load an input into a writer context.
+/// Load an input into a writer context. If \p NumShards is greater than one,
+/// only the functions whose name hashes to \p Shard are loaded.
 static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
-                      WriterContext *WC) {
+                      WriterContext *WC, unsigned Shard = 0,
+                      unsigned NumShards = 1) {
   std::unique_lock<std::mutex> CtxGuard{WC->Lock};
 
   // Copy the filename, because llvm::ThreadPool copied the input "const
@@ -254,6 +256,9 @@ static void loadInput(const WeightedFile &Input, SymbolRemapper *Remapper,
   for (auto &I : *Reader) {
     if (Remapper)
       I.Name = (*Remapper)(I.Name);
+    if (NumShards > 1 &&
+        IndexedInstrProf::ComputeHash(I.Name) % NumShards != Shard)
+      continue;
     const StringRef FuncName = I.Name;
     bool Reported = false;
     WC->Writer.addRecord(std::move(I), Input.Weight, [&](Error E) {
@@ -290,11 +295,54 @@ static void mergeWriterContexts(WriterContext *Dst, WriterContext *Src) {
   });
 }
 
+/// Load the functions of \p Shard out of \p NumShards from all \p Inputs into
+/// \p Contexts, and merge them into the first context.
+static void loadAndMergeInputs(const WeightedFileVector &Inputs,
+                               SymbolRemapper *Remapper,
+                               ArrayRef<std::unique_ptr<WriterContext>> Contexts,
+                               unsigned Shard, unsigned NumShards) {
+  if (Contexts.size() == 1) {
+    for (const auto &Input : Inputs)
+      loadInput(Input, Remapper, Contexts[0].get(), Shard, NumShards);
+    return;
+  }
+
+  ThreadPool Pool(Contexts.size());
+
+  // Load the inputs in parallel (N/NumThreads serial steps).
+  unsigned Ctx = 0;
+  for (const auto &Input : Inputs) {
+    Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get(), Shard,
+               NumShards);
+    Ctx = (Ctx + 1) % Contexts.size();
+  }
+  Pool.wait();
+
+  // Merge the writer contexts together (~ lg(NumThreads) serial steps).
+  unsigned Mid = Contexts.size() / 2;
+  unsigned End = Contexts.size();
+  assert(Mid > 0 && "Expected more than one context");
+  do {
+    for (unsigned I = 0; I < Mid; ++I)
+      Pool.async(mergeWriterContexts, Contexts[I].get(),
+                 Contexts[I + Mid].get());
+    Pool.wait();
+    if (End & 1) {
+      Pool.async(mergeWriterContexts, Contexts[0].get(),
+                 Contexts[End - 1].get());
+      Pool.wait();
+    }
+    End = Mid;
+    Mid /= 2;
+  } while (Mid > 0);
+}
+
 static void mergeInstrProfile(const WeightedFileVector &Inputs,
                               SymbolRemapper *Remapper,
                               StringRef OutputFilename,
                               ProfileFormat OutputFormat, bool OutputSparse,
-                              unsigned NumThreads, FailureMode FailMode) {
+                              unsigned NumThreads, unsigned NumShards,
+                              FailureMode FailMode) {
   if (OutputFilename.compare("-") == 0)
     exitWithError("Cannot write indexed profdata format to stdout.");
 
@@ -309,54 +357,40 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   if (NumThreads == 0)
     NumThreads =
         std::min(hardware_concurrency(), unsigned((Inputs.size() + 1) / 2));
-
-  // Initialize the writer contexts.
-  SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
-  for (unsigned I = 0; I < NumThreads; ++I)
-    Contexts.emplace_back(std::make_unique<WriterContext>(
-        OutputSparse, ErrorLock, WriterErrorCodes));
-
-  if (NumThreads == 1) {
-    for (const auto &Input : Inputs)
-      loadInput(Input, Remapper, Contexts[0].get());
-  } else {
-    ThreadPool Pool(NumThreads);
-
-    // Load the inputs in parallel (N/NumThreads serial steps).
-    unsigned Ctx = 0;
-    for (const auto &Input : Inputs) {
-      Pool.async(loadInput, Input, Remapper, Contexts[Ctx].get());
-      Ctx = (Ctx + 1) % NumThreads;
+  NumShards = std::max(NumShards, 1u);
+
+  // The per-thread contexts each end up holding a merged copy of every
+  // function they have seen, so their total size grows with NumThreads times
+  // the size of the output. With several shards, every pass over the inputs
+  // only merges the functions of one shard, and the result of each pass is
+  // moved into the final writer before the next one starts.
+  std::unique_ptr<WriterContext> Result;
+  for (unsigned Shard = 0; Shard < NumShards; ++Shard) {
+    SmallVector<std::unique_ptr<WriterContext>, 4> Contexts;
+    for (unsigned I = 0; I < NumThreads; ++I)
+      Contexts.emplace_back(std::make_unique<WriterContext>(
+          OutputSparse, ErrorLock, WriterErrorCodes));
+
+    loadAndMergeInputs(Inputs, Remapper, Contexts, Shard, NumShards);
+
+    if (!Result) {
+      Result = std::move(Contexts[0]);
+      continue;
     }
-    Pool.wait();
-
-    // Merge the writer contexts together (~ lg(NumThreads) serial steps).
-    unsigned Mid = Contexts.size() / 2;
-    unsigned End = Contexts.size();
-    assert(Mid > 0 && "Expected more than one context");
-    do {
-      for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
-      Pool.wait();
-      if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
-        Pool.wait();
-      }
-      End = Mid;
-      Mid /= 2;
-    } while (Mid > 0);
+    // Every pass reads the same inputs and runs into the same errors, which
+    // have already been recorded by the first one.
+    for (auto &ErrorPair : Contexts[0]->Errors)
+      consumeError(std::move(ErrorPair.first));
+    Contexts[0]->Errors.clear();
+    mergeWriterContexts(Result.get(), Contexts[0].get());
   }
 
   // Handle deferred errors encountered during merging. If the number of errors
   // is equal to the number of inputs the merge failed.
   unsigned NumErrors = 0;
-  for (std::unique_ptr<WriterContext> &WC : Contexts) {
-    for (auto &ErrorPair : WC->Errors) {
-      ++NumErrors;
-      warn(toString(std::move(ErrorPair.first)), ErrorPair.second);
-    }
+  for (auto &ErrorPair : Result->Errors) {
+    ++NumErrors;
+    warn(toString(std::move(ErrorPair.first)), ErrorPair.second);
   }
   if (NumErrors == Inputs.size() ||
       (NumErrors > 0 && FailMode == failIfAnyAreInvalid))
@@ -367,7 +401,7 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   if (EC)
     exitWithErrorCode(EC, OutputFilename);
 
-  InstrProfWriter &Writer = Contexts[0]->Writer;
+  InstrProfWriter &Writer = Result->Writer;
   if (OutputFormat == PF_Text) {
     if (Error E = Writer.writeText(Output))
       exitWithError(std::move(E));
@@ -645,6 +679,11 @@ static int merge_main(int argc, const char *argv[]) {
       cl::desc("Number of merge threads to use (default: autodetect)"));
   cl::alias NumThreadsA("j", cl::desc("Alias for --num-threads"),
                         cl::aliasopt(NumThreads));
+  cl::opt<unsigned> NumShards(
+      "num-shards", cl::init(1),
+      cl::desc("Merge instrumentation profiles in N passes over the inputs, "
+               "each covering a disjoint subset of the functions, to reduce "
+               "peak memory usage"));
   cl::opt<std::string> ProfileSymbolListFile(
       "prof-sym-list", cl::init(""),
       cl::desc("Path to file containing the list of function symbols "
@@ -683,7 +722,8 @@ static int merge_main(int argc, const char *argv[]) {
 
   if (ProfileKind == instr)
     mergeInstrProfile(WeightedInputs, Remapper.get(), OutputFilename,
-                      OutputFormat, OutputSparse, NumThreads, FailureMode);
+                      OutputFormat, OutputSparse, NumThreads, NumShards,
+                      FailureMode);
   else
     mergeSampleProfile(WeightedInputs, Remapper.get(), OutputFilename,
                        OutputFormat, ProfileSymbolListFile, CompressAllSections,
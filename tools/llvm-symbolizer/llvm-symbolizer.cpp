@@ -14,6 +14,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "llvm/ADT/Optional.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/DebugInfo/Symbolize/DIPrinter.h"
 #include "llvm/DebugInfo/Symbolize/Symbolize.h"
@@ -26,6 +27,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <cstdio>
 #include <cstring>
+#include <map>
 #include <string>
 
 using namespace llvm;
@@ -142,6 +144,18 @@ static cl::opt<uint64_t>
     ClAdjustVMA("adjust-vma", cl::init(0), cl::value_desc("offset"),
                 cl::desc("Add specified offset to object file addresses"));
 
+static cl::opt<bool>
+    ClBatch("batch", cl::init(false),
+            cl::desc("Read all input addresses before symbolizing them, and "
+                     "symbolize the code addresses of each module together"));
+
+// -cache-size
+static cl::opt<uint64_t>
+    ClCacheSize("cache-size", cl::init(0), cl::value_desc("bytes"),
+                cl::desc("Max total file size in bytes of the binaries kept "
+                         "open (0 means unlimited). Memory used by parsed "
+                         "debug info is not counted"));
+
 static cl::list<std::string> ClInputAddresses(cl::Positional,
                                               cl::desc("<input addresses>..."),
                                               cl::ZeroOrMore);
@@ -216,8 +230,11 @@ static bool parseCommand(StringRef InputString, Command &Cmd,
   return !StringRef(pos, offset_length).getAsInteger(0, ModuleOffset);
 }
 
+/// Symbolize \p InputString and print the result. \p Batched, if not null, is
+/// the already computed inlining info of a code address.
 static void symbolizeInput(StringRef InputString, LLVMSymbolizer &Symbolizer,
-                           DIPrinter &Printer) {
+                           DIPrinter &Printer,
+                           const DIInliningInfo *Batched = nullptr) {
   Command Cmd;
   std::string ModuleName;
   uint64_t Offset = 0;
@@ -246,6 +263,11 @@ static void symbolizeInput(StringRef InputString, LLVMSymbolizer &Symbolizer,
       if (ResOrErr->empty())
         outs() << "??\n";
     }
+  } else if (Batched) {
+    if (ClPrintInlining)
+      Printer << *Batched;
+    else
+      Printer << Batched->getFrame(0);
   } else if (ClPrintInlining) {
     auto ResOrErr = Symbolizer.symbolizeInlinedCode(
         ModuleName, {Offset, object::SectionedAddress::UndefSection});
@@ -269,6 +291,46 @@ static void symbolizeInput(StringRef InputString, LLVMSymbolizer &Symbolizer,
     outs() << "\n";
 }
 
+/// Symbolize all of \p Inputs, querying the code addresses of each module with
+/// a single batch request.
+static void symbolizeBatch(ArrayRef<std::string> Inputs,
+                           LLVMSymbolizer &Symbolizer, DIPrinter &Printer) {
+  // Only code queries printed from inlining info can be batched; everything
+  // else goes through symbolizeInput() as usual.
+  bool CanBatch =
+      ClPrintInlining || ClOutputStyle == DIPrinter::OutputStyle::GNU;
+  std::vector<Optional<DIInliningInfo>> Results(Inputs.size());
+  if (CanBatch) {
+    std::map<std::string, std::vector<unsigned>> InputsByModule;
+    std::vector<uint64_t> Offsets(Inputs.size());
+    for (unsigned I = 0, E = Inputs.size(); I != E; ++I) {
+      Command Cmd;
+      std::string ModuleName;
+      if (parseCommand(Inputs[I], Cmd, ModuleName, Offsets[I]) &&
+          Cmd == Command::Code)
+        InputsByModule[ModuleName].push_back(I);
+    }
+
+    for (const auto &Entry : InputsByModule) {
+      std::vector<object::SectionedAddress> Addresses;
+      for (unsigned I : Entry.second)
+        Addresses.push_back(
+            {Offsets[I] - ClAdjustVMA, object::SectionedAddress::UndefSection});
+      auto ResOrErr = Symbolizer.symbolizeInlinedCode(Entry.first, Addresses);
+      // Report a module that fails to load once, as without --batch, and leave
+      // its results unset. symbolizeInput() then prints "??" for each address.
+      if (error(ResOrErr))
+        continue;
+      for (unsigned I = 0, E = Entry.second.size(); I != E; ++I)
+        Results[Entry.second[I]] = std::move((*ResOrErr)[I]);
+    }
+  }
+
+  for (unsigned I = 0, E = Inputs.size(); I != E; ++I)
+    symbolizeInput(Inputs[I], Symbolizer, Printer,
+                   Results[I] ? Results[I].getPointer() : nullptr);
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
 
@@ -299,6 +361,7 @@ int main(int argc, char **argv) {
   Opts.DefaultArch = ClDefaultArch;
   Opts.FallbackDebugPath = ClFallbackDebugPath;
   Opts.DWPName = ClDwpName;
+  Opts.MaxCacheSize = ClCacheSize;
 
   for (const auto &hint : ClDsymHint) {
     if (sys::path::extension(hint) == ".dSYM") {
@@ -314,17 +377,30 @@ int main(int argc, char **argv) {
                     ClPrettyPrint, ClPrintSourceContextLines, ClVerbose,
                     ClBasenames, ClOutputStyle);
 
-  if (ClInputAddresses.empty()) {
+  if (ClBatch) {
+    std::vector<std::string> Inputs(ClInputAddresses.begin(),
+                                    ClInputAddresses.end());
+    if (Inputs.empty()) {
+      const int kMaxInputStringLength = 1024;
+      char InputString[kMaxInputStringLength];
+      while (fgets(InputString, sizeof(InputString), stdin))
+        Inputs.push_back(InputString);
+    }
+    symbolizeBatch(Inputs, Symbolizer, Printer);
+  } else if (ClInputAddresses.empty()) {
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
     while (fgets(InputString, sizeof(InputString), stdin)) {
       symbolizeInput(InputString, Symbolizer, Printer);
       outs().flush();
+      Symbolizer.pruneCache();
     }
   } else {
-    for (StringRef Address : ClInputAddresses)
+    for (StringRef Address : ClInputAddresses) {
       symbolizeInput(Address, Symbolizer, Printer);
+      Symbolizer.pruneCache();
+    }
   }
 
   return 0;
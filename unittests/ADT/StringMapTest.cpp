@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/DataTypes.h"
 #include "gtest/gtest.h"
@@ -547,4 +548,29 @@ TEST(StringMapCustomTest, StringMapEntrySize) {
   EXPECT_EQ(LargeValue, Key.size());
 }
 
+TEST(StringMapCustomTest, PrecomputedHash) {
+  StringMap<int> Map;
+  StringRef Keys[] = {"", "a", "foo", "a much longer key than the others"};
+  for (unsigned I = 0; I < array_lengthof(Keys); ++I) {
+    uint32_t Hash = StringMap<int>::hash(Keys[I]);
+    EXPECT_EQ(0u, Map.count(Keys[I], Hash));
+    auto Try = Map.try_emplace_with_hash(Keys[I], Hash, I);
+    EXPECT_TRUE(Try.second);
+    EXPECT_EQ(Keys[I], Try.first->getKey());
+    Try = Map.try_emplace_with_hash(Keys[I], Hash, 100);
+    EXPECT_FALSE(Try.second);
+    EXPECT_EQ(int(I), Try.first->second);
+  }
+
+  // Lookups with and without the precomputed hash agree.
+  const StringMap<int> &ConstMap = Map;
+  for (unsigned I = 0; I < array_lengthof(Keys); ++I) {
+    uint32_t Hash = StringMap<int>::hash(Keys[I]);
+    EXPECT_EQ(1u, Map.count(Keys[I], Hash));
+    EXPECT_EQ(Map.find(Keys[I]), Map.find(Keys[I], Hash));
+    EXPECT_EQ(ConstMap.find(Keys[I]), ConstMap.find(Keys[I], Hash));
+    EXPECT_EQ(int(I), Map.find(Keys[I], Hash)->second);
+  }
+}
+
 } // end anonymous namespace
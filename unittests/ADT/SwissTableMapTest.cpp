@@ -0,0 +1,252 @@
+//===- llvm/unittest/ADT/SwissTableMapTest.cpp - SwissTableMap unit tests -===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/SwissTableMap.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+/// A hash that sends every key to the same group, which makes every lookup
+/// run the whole probe sequence.
+struct CollidingInfo {
+  static unsigned getHashValue(unsigned) { return 42; }
+  static bool isEqual(unsigned LHS, unsigned RHS) { return LHS == RHS; }
+};
+
+TEST(SwissTableMapTest, EmptyMap) {
+  SwissTableMap<unsigned, unsigned> Map;
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_TRUE(Map.empty());
+  EXPECT_TRUE(Map.begin() == Map.end());
+  EXPECT_EQ(0u, Map.count(1));
+  EXPECT_TRUE(Map.find(1) == Map.end());
+  EXPECT_EQ(0u, Map.lookup(1));
+  EXPECT_FALSE(Map.erase(1));
+  EXPECT_EQ(0u, Map.getMemorySize());
+
+  const SwissTableMap<unsigned, unsigned> &ConstMap = Map;
+  EXPECT_TRUE(ConstMap.begin() == ConstMap.end());
+  EXPECT_TRUE(ConstMap.find(1) == ConstMap.end());
+}
+
+TEST(SwissTableMapTest, SingleEntry) {
+  SwissTableMap<unsigned, unsigned> Map;
+  Map[7] = 42;
+  EXPECT_EQ(1u, Map.size());
+  EXPECT_FALSE(Map.empty());
+  EXPECT_EQ(1u, Map.count(7));
+  EXPECT_EQ(42u, Map.lookup(7));
+  EXPECT_EQ(42u, Map[7]);
+  EXPECT_EQ(1u, Map.size());
+
+  auto I = Map.find(7);
+  ASSERT_TRUE(I != Map.end());
+  EXPECT_EQ(7u, I->first);
+  EXPECT_EQ(42u, I->second);
+  EXPECT_TRUE(++I == Map.end());
+}
+
+TEST(SwissTableMapTest, InsertAndTryEmplace) {
+  SwissTableMap<unsigned, std::string> Map;
+  auto R = Map.insert(std::make_pair(1u, std::string("one")));
+  EXPECT_TRUE(R.second);
+  EXPECT_EQ("one", R.first->second);
+
+  R = Map.insert(std::make_pair(1u, std::string("uno")));
+  EXPECT_FALSE(R.second);
+  EXPECT_EQ("one", R.first->second);
+
+  R = Map.try_emplace(2u, 3, 'x');
+  EXPECT_TRUE(R.second);
+  EXPECT_EQ("xxx", R.first->second);
+  R = Map.try_emplace(2u, "ignored");
+  EXPECT_FALSE(R.second);
+  EXPECT_EQ("xxx", Map.lookup(2));
+  EXPECT_EQ(2u, Map.size());
+}
+
+TEST(SwissTableMapTest, Growth) {
+  SwissTableMap<unsigned, unsigned> Map;
+  for (unsigned I = 0; I < 10000; ++I)
+    Map[I] = I * 3;
+  EXPECT_EQ(10000u, Map.size());
+  for (unsigned I = 0; I < 10000; ++I)
+    EXPECT_EQ(I * 3, Map.lookup(I));
+  EXPECT_EQ(0u, Map.count(10000));
+}
+
+TEST(SwissTableMapTest, Reserve) {
+  SwissTableMap<unsigned, unsigned> Map(1000);
+  size_t MemorySize = Map.getMemorySize();
+  EXPECT_NE(0u, MemorySize);
+  for (unsigned I = 0; I < 1000; ++I)
+    Map[I] = I;
+  // Reserving enough space up front means the map never has to grow.
+  EXPECT_EQ(MemorySize, Map.getMemorySize());
+  Map.reserve(10);
+  EXPECT_EQ(MemorySize, Map.getMemorySize());
+}
+
+TEST(SwissTableMapTest, EraseAndReinsert) {
+  SwissTableMap<unsigned, unsigned> Map;
+  for (unsigned I = 0; I < 1000; ++I)
+    Map[I] = I;
+  for (unsigned I = 0; I < 1000; I += 2)
+    EXPECT_TRUE(Map.erase(I));
+  EXPECT_FALSE(Map.erase(0));
+  EXPECT_EQ(500u, Map.size());
+  for (unsigned I = 0; I < 1000; ++I)
+    EXPECT_EQ(I % 2, Map.count(I));
+
+  auto It = Map.find(1);
+  Map.erase(It);
+  EXPECT_EQ(0u, Map.count(1));
+  EXPECT_EQ(499u, Map.size());
+
+  // Repeated erase/insert cycles must reuse deleted buckets rather than grow
+  // without bound.
+  size_t MemorySize = Map.getMemorySize();
+  for (unsigned Round = 0; Round < 100; ++Round) {
+    for (unsigned I = 0; I < 100; ++I)
+      Map[100000 + Round * 100 + I] = I;
+    for (unsigned I = 0; I < 100; ++I)
+      Map.erase(100000 + Round * 100 + I);
+  }
+  EXPECT_EQ(499u, Map.size());
+  EXPECT_EQ(MemorySize, Map.getMemorySize());
+}
+
+TEST(SwissTableMapTest, Collisions) {
+  SwissTableMap<unsigned, unsigned, CollidingInfo> Map;
+  for (unsigned I = 0; I < 200; ++I)
+    Map[I] = I + 1;
+  for (unsigned I = 0; I < 200; I += 3)
+    Map.erase(I);
+  for (unsigned I = 0; I < 200; ++I)
+    EXPECT_EQ(I % 3 ? I + 1 : 0, Map.lookup(I));
+  EXPECT_EQ(0u, Map.count(200));
+}
+
+TEST(SwissTableMapTest, Iteration) {
+  SwissTableMap<unsigned, unsigned> Map;
+  for (unsigned I = 0; I < 100; ++I)
+    Map[I * 7] = I;
+  Map.erase(14);
+
+  std::map<unsigned, unsigned> Seen;
+  for (const auto &KV : Map)
+    EXPECT_TRUE(Seen.insert(std::make_pair(KV.first, KV.second)).second);
+  EXPECT_EQ(99u, Seen.size());
+  for (const auto &KV : Seen)
+    EXPECT_EQ(KV.first, KV.second * 7);
+
+  // Non-const iterators convert to const ones and allow modification.
+  for (auto &KV : Map)
+    KV.second = 0;
+  SwissTableMap<unsigned, unsigned>::const_iterator CI = Map.begin();
+  EXPECT_TRUE(CI == Map.begin());
+  for (const auto &KV : Map)
+    EXPECT_EQ(0u, KV.second);
+}
+
+TEST(SwissTableMapTest, CopyAndMove) {
+  SwissTableMap<unsigned, std::string> Map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  EXPECT_EQ(3u, Map.size());
+
+  SwissTableMap<unsigned, std::string> Copy(Map);
+  EXPECT_EQ(3u, Copy.size());
+  EXPECT_EQ("b", Copy.lookup(2));
+  Copy[2] = "z";
+  EXPECT_EQ("b", Map.lookup(2));
+
+  SwissTableMap<unsigned, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(3u, Moved.size());
+  EXPECT_EQ("z", Moved.lookup(2));
+  EXPECT_TRUE(Copy.empty());
+
+  Copy = Map;
+  EXPECT_EQ("b", Copy.lookup(2));
+  Copy = std::move(Moved);
+  EXPECT_EQ("z", Copy.lookup(2));
+
+  Copy.swap(Map);
+  EXPECT_EQ("z", Map.lookup(2));
+  EXPECT_EQ("b", Copy.lookup(2));
+
+  Map.clear();
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(0u, Map.count(1));
+  Map[4] = "d";
+  EXPECT_EQ(1u, Map.size());
+}
+
+TEST(SwissTableMapTest, NonTrivialValues) {
+  SwissTableMap<unsigned, std::unique_ptr<unsigned>> Map;
+  for (unsigned I = 0; I < 500; ++I)
+    Map[I] = std::make_unique<unsigned>(I);
+  for (unsigned I = 0; I < 500; I += 5)
+    Map.erase(I);
+  for (unsigned I = 0; I < 500; ++I) {
+    auto It = Map.find(I);
+    if (I % 5 == 0) {
+      EXPECT_TRUE(It == Map.end());
+      continue;
+    }
+    ASSERT_TRUE(It != Map.end());
+    EXPECT_EQ(I, *It->second);
+  }
+}
+
+TEST(SwissTableMapTest, PointerKeys) {
+  int Objects[64];
+  SwissTableMap<int *, unsigned> Map;
+  for (unsigned I = 0; I < 64; ++I)
+    Map[&Objects[I]] = I;
+  for (unsigned I = 0; I < 64; ++I)
+    EXPECT_EQ(I, Map.lookup(&Objects[I]));
+  EXPECT_EQ(0u, Map.count(nullptr));
+}
+
+TEST(SwissTableMapTest, RandomOperations) {
+  std::mt19937 Rng(0);
+  SwissTableMap<unsigned, unsigned> Map;
+  std::map<unsigned, unsigned> Reference;
+  for (unsigned Step = 0; Step < 50000; ++Step) {
+    unsigned Key = Rng() % 2000;
+    switch (Rng() % 3) {
+    case 0:
+      Map[Key] = Step;
+      Reference[Key] = Step;
+      break;
+    case 1:
+      EXPECT_EQ(Reference.erase(Key) == 1, Map.erase(Key));
+      break;
+    case 2: {
+      auto It = Reference.find(Key);
+      EXPECT_EQ(It == Reference.end() ? 0 : It->second, Map.lookup(Key));
+      break;
+    }
+    }
+    ASSERT_EQ(Reference.size(), Map.size());
+  }
+
+  unsigned Count = 0;
+  for (const auto &KV : Map) {
+    EXPECT_EQ(Reference[KV.first], KV.second);
+    ++Count;
+  }
+  EXPECT_EQ(Reference.size(), Count);
+}
+
+} // end anonymous namespace
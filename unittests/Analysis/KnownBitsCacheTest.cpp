@@ -0,0 +1,169 @@
+//===- KnownBitsCacheTest.cpp - KnownBitsCache unit tests -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Analysis/KnownBitsCache.h"
+#include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/SourceMgr.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+class KnownBitsCacheTest : public testing::Test {
+protected:
+  void parseAssembly(const char *Assembly) {
+    SMDiagnostic Error;
+    M = parseAssemblyString(Assembly, Error, Context);
+
+    std::string errMsg;
+    raw_string_ostream os(errMsg);
+    Error.print("", os);
+
+    // A failure here means that the test itself is buggy.
+    if (!M)
+      report_fatal_error(os.str());
+
+    F = M->getFunction("test");
+    if (!F)
+      report_fatal_error("Test must have a function named @test");
+  }
+
+  Instruction *getInstruction(StringRef Name) {
+    for (Instruction &I : instructions(F))
+      if (I.getName() == Name)
+        return &I;
+    report_fatal_error("Test instruction not found");
+  }
+
+  LLVMContext Context;
+  std::unique_ptr<Module> M;
+  Function *F = nullptr;
+};
+
+TEST_F(KnownBitsCacheTest, Queries) {
+  parseAssembly("define i8 @test(i8 %x, i8* nonnull %p) {\n"
+                "  %a = and i8 %x, 15\n"
+                "  %b = or i8 %a, 16\n"
+                "  %c = ashr i8 %x, 4\n"
+                "  %d = getelementptr i8, i8* %p, i64 1\n"
+                "  ret i8 %b\n"
+                "}\n");
+  KnownBitsCache KBC(*F);
+
+  KnownBits Known = KBC.getKnownBits(getInstruction("b"));
+  EXPECT_EQ(Known.Zero.getZExtValue(), 0xE0u);
+  EXPECT_EQ(Known.One.getZExtValue(), 0x10u);
+  EXPECT_TRUE(KBC.isKnownNonZero(getInstruction("b")));
+  EXPECT_FALSE(KBC.isKnownNonZero(getInstruction("a")));
+  EXPECT_EQ(KBC.getNumSignBits(getInstruction("c")), 5u);
+  EXPECT_TRUE(KBC.isKnownNonZero(&*std::next(F->arg_begin())));
+
+  ConstantRange CR = KBC.getConstantRange(getInstruction("b"), false);
+  EXPECT_EQ(CR.getUnsignedMin().getZExtValue(), 16u);
+  EXPECT_EQ(CR.getUnsignedMax().getZExtValue(), 31u);
+
+  // Constants are answered, but not cached.
+  Known = KBC.getKnownBits(ConstantInt::get(Type::getInt8Ty(Context), 5));
+  EXPECT_EQ(Known.One.getZExtValue(), 5u);
+}
+
+TEST_F(KnownBitsCacheTest, ConstantRange) {
+  parseAssembly("define i8 @test(i8 %x) {\n"
+                "  %u = urem i8 %x, 10\n"
+                "  %s = srem i8 %x, 10\n"
+                "  ret i8 %u\n"
+                "}\n");
+  KnownBitsCache KBC(*F);
+
+  // The known bits only bound the remainders by the divisor's leading zeros,
+  // so the ranges come from computeConstantRange.
+  ConstantRange CR = KBC.getConstantRange(getInstruction("u"), false);
+  EXPECT_EQ(CR, ConstantRange(APInt(8, 0), APInt(8, 10)));
+  CR = KBC.getConstantRange(getInstruction("s"), true);
+  EXPECT_EQ(CR, ConstantRange(APInt(8, -9, true), APInt(8, 10)));
+
+  // Asking again gives the cached range.
+  CR = KBC.getConstantRange(getInstruction("u"), false);
+  EXPECT_EQ(CR, ConstantRange(APInt(8, 0), APInt(8, 10)));
+}
+
+TEST_F(KnownBitsCacheTest, SimplifyInstruction) {
+  parseAssembly("define i1 @test(i8 %x) {\n"
+                "  %a = or i8 %x, 1\n"
+                "  %b = trunc i8 %a to i1\n"
+                "  ret i1 %b\n"
+                "}\n");
+  KnownBitsCache KBC(*F);
+
+  // InstSimplify folds %b through its known bits, and leaves them cached.
+  SimplifyQuery Q(M->getDataLayout());
+  Q.KBC = &KBC;
+  Value *V = SimplifyInstruction(getInstruction("b"), Q);
+  EXPECT_EQ(V, ConstantInt::getTrue(Context));
+
+  std::string Str;
+  raw_string_ostream OS(Str);
+  KBC.print(OS);
+  EXPECT_EQ(OS.str(), "  %b: zero=0x0 one=0x1\n");
+}
+
+TEST_F(KnownBitsCacheTest, InvalidateValue) {
+  parseAssembly("define i8 @test(i8 %x) {\n"
+                "  %a = and i8 %x, 15\n"
+                "  %b = or i8 %a, 16\n"
+                "  %c = add i8 %b, 0\n"
+                "  ret i8 %c\n"
+                "}\n");
+  KnownBitsCache KBC(*F);
+  Instruction *A = getInstruction("a");
+  Instruction *C = getInstruction("c");
+
+  EXPECT_EQ(KBC.getKnownBits(C).Zero.getZExtValue(), 0xE0u);
+
+  // Modifying an instruction in place isn't noticed until the cache is told.
+  A->setOperand(1, ConstantInt::get(A->getType(), 7));
+  EXPECT_EQ(KBC.getKnownBits(C).Zero.getZExtValue(), 0xE0u);
+
+  // Invalidating the operand also forgets the users computed from it.
+  KBC.invalidateValue(A);
+  EXPECT_EQ(KBC.getKnownBits(C).Zero.getZExtValue(), 0xE8u);
+}
+
+TEST_F(KnownBitsCacheTest, ReplaceAndDelete) {
+  parseAssembly("define i8 @test(i8 %x) {\n"
+                "  %a = and i8 %x, 15\n"
+                "  %b = or i8 %a, 16\n"
+                "  ret i8 %b\n"
+                "}\n");
+  KnownBitsCache KBC(*F);
+  Instruction *A = getInstruction("a");
+  Instruction *B = getInstruction("b");
+
+  EXPECT_EQ(KBC.getKnownBits(A).Zero.getZExtValue(), 0xF0u);
+  EXPECT_EQ(KBC.getKnownBits(B).Zero.getZExtValue(), 0xE0u);
+
+  // Replacing a cached value forgets its users.
+  A->replaceAllUsesWith(ConstantInt::get(A->getType(), 1));
+  EXPECT_EQ(KBC.getKnownBits(B).Zero.getZExtValue(), 0xEEu);
+  EXPECT_EQ(KBC.getKnownBits(B).One.getZExtValue(), 0x11u);
+
+  // Deleting a cached value is fine, and so is querying after that.
+  EXPECT_EQ(KBC.getKnownBits(A).Zero.getZExtValue(), 0xF0u);
+  A->eraseFromParent();
+  EXPECT_EQ(KBC.getKnownBits(B).One.getZExtValue(), 0x11u);
+}
+
+} // end anonymous namespace
@@ -12,7 +12,9 @@
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -414,4 +416,147 @@ TEST(AsmParserTest, TypeAtBeginningWithSlotMappingParsing) {
   ASSERT_TRUE(Read == 4);
 }
 
+static std::unique_ptr<Module> parseLazily(StringRef Source, LLVMContext &Ctx) {
+  SMDiagnostic Error;
+  auto Mod = parseAssemblyLazily(
+      MemoryBuffer::getMemBufferCopy(Source, "<string>"), Error, Ctx);
+  EXPECT_TRUE(Mod != nullptr) << Error.getMessage().str();
+  return Mod;
+}
+
+static std::string printModule(const Module &M) {
+  std::string Str;
+  raw_string_ostream OS(Str);
+  M.print(OS, nullptr);
+  return OS.str();
+}
+
+TEST(AsmParserTest, LazyFunctionBodies) {
+  // The modules compared need contexts of their own for their types to get the
+  // same names.
+  LLVMContext Ctx, LazyCtx;
+  StringRef Source = "%T = type { i32, %T* }\n"
+                     "@g = global i32 0\n"
+                     "define i32 @f(i32 %x) !attach !0 {\n"
+                     "  %y = add i32 %x, 1\n"
+                     "  %z = call i32 @1(i32 %y)\n"
+                     "  ret i32 %z\n"
+                     "}\n"
+                     "define i32 @0(i32 %x) {\n"
+                     "  %p = alloca %T\n"
+                     "  %v = load i32, i32* @g, !range !1\n"
+                     "  ret i32 %v\n"
+                     "}\n"
+                     "define internal i32 @1(i32 %x) {\n"
+                     "  %r = call i32 @0(i32 %x)\n"
+                     "  %s = call i32 @0(i32 %r)\n"
+                     "  ret i32 %s\n"
+                     "}\n"
+                     "!0 = !{}\n"
+                     "!1 = !{i32 0, i32 10}\n"
+                     "uselistorder i32 (i32)* @0, { 1, 0 }\n";
+  SMDiagnostic Error;
+  auto Eager = parseAssemblyString(Source, Error, Ctx);
+  ASSERT_TRUE(Eager != nullptr);
+
+  // Without the uselistorder directive, no body is parsed.
+  auto Mod = parseLazily(Source.substr(0, Source.find("uselistorder")), Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+  Function *F = Mod->getFunction("f");
+  EXPECT_TRUE(F->isMaterializable());
+  EXPECT_FALSE(F->hasMetadata());
+  EXPECT_EQ(Mod->getIdentifiedStructTypes().size(), 1u);
+
+  ASSERT_FALSE(bool(F->materialize()));
+  EXPECT_FALSE(F->isMaterializable());
+  EXPECT_TRUE(F->getMetadata("attach") != nullptr);
+  EXPECT_EQ(F->front().size(), 3u);
+  EXPECT_TRUE(Mod->getFunctionList().back().isMaterializable());
+
+  // The bodies parsed later get the same slot numbers and metadata.
+  Mod = parseLazily(Source, LazyCtx);
+  ASSERT_TRUE(Mod != nullptr);
+  ASSERT_FALSE(bool(Mod->materializeAll()));
+  EXPECT_EQ(printModule(*Eager), printModule(*Mod));
+}
+
+TEST(AsmParserTest, LazyBlockAddress) {
+  LLVMContext Ctx;
+  auto Mod = parseLazily("@addr = global i8* blockaddress(@f, %bb)\n"
+                         "define void @f() {\n"
+                         "  br label %bb\n"
+                         "bb:\n"
+                         "  ret void\n"
+                         "}\n"
+                         "define i8* @g() {\n"
+                         "  ret i8* blockaddress(@h, %bb)\n"
+                         "}\n"
+                         "define void @h() {\n"
+                         "  br label %bb\n"
+                         "bb:\n"
+                         "  ret void\n"
+                         "}\n",
+                         Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+
+  // Global initializers are resolved when the module is parsed.
+  EXPECT_FALSE(Mod->getFunction("f")->isMaterializable());
+  auto *BA = cast<BlockAddress>(Mod->getNamedGlobal("addr")->getInitializer());
+  EXPECT_EQ(BA->getBasicBlock()->getName(), "bb");
+
+  // Function bodies when they're materialized.
+  Function *H = Mod->getFunction("h");
+  EXPECT_TRUE(H->isMaterializable());
+  ASSERT_FALSE(bool(Mod->getFunction("g")->materialize()));
+  EXPECT_FALSE(H->isMaterializable());
+  EXPECT_TRUE(std::next(H->begin())->hasAddressTaken());
+}
+
+TEST(AsmParserTest, LazyFunctionBodyError) {
+  LLVMContext Ctx;
+  auto Mod = parseLazily("define i32 @f() {\n"
+                         "  ret i32 0\n"
+                         "}\n"
+                         "define i32 @g() {\n"
+                         "  ret i64 0 ; \"}\"\n"
+                         "}\n",
+                         Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+  EXPECT_FALSE(bool(Mod->getFunction("f")->materialize()));
+  std::string Message = toString(Mod->getFunction("g")->materialize());
+  EXPECT_EQ(Message, "<string>:5:7: value doesn't match function result type "
+                     "'i32'");
+
+  // Unbalanced braces are found when skipping over the body.
+  SMDiagnostic Error;
+  EXPECT_TRUE(parseAssemblyLazily(MemoryBuffer::getMemBufferCopy(
+                                      "define void @f() {\n  ret void\n"),
+                                  Error, Ctx) == nullptr);
+  EXPECT_EQ(Error.getMessage(), "expected matching '}'");
+}
+
+TEST(AsmParserTest, LazyIntrinsicUpgrade) {
+  LLVMContext Ctx;
+  StringRef Source = "declare i32 @llvm.ctlz.i32(i32)\n"
+                     "define i32 @f(i32 %x) {\n"
+                     "  %r = call i32 @llvm.ctlz.i32(i32 %x)\n"
+                     "  ret i32 %r\n"
+                     "}\n";
+  SMDiagnostic Error;
+  auto Eager = parseAssemblyString(Source, Error, Ctx);
+  ASSERT_TRUE(Eager != nullptr);
+
+  auto Mod = parseLazily(Source, Ctx);
+  ASSERT_TRUE(Mod != nullptr);
+  Function *NewFn = Mod->getFunction("llvm.ctlz.i32");
+  ASSERT_TRUE(NewFn != nullptr);
+  EXPECT_EQ(NewFn->arg_size(), 2u);
+
+  // The body's call to the old declaration is upgraded to the new one.
+  ASSERT_FALSE(bool(Mod->getFunction("f")->materialize()));
+  EXPECT_FALSE(NewFn->materialized_use_empty());
+  ASSERT_FALSE(bool(Mod->materializeAll()));
+  EXPECT_EQ(printModule(*Eager), printModule(*Mod));
+}
+
 } // end anonymous namespace
@@ -12,6 +12,7 @@
 #include "llvm/ExecutionEngine/Orc/OrcError.h"
 #include "llvm/Testing/Support/Error.h"
 
+#include <atomic>
 #include <set>
 #include <thread>
 
@@ -208,6 +209,13 @@ TEST_F(CoreAPIsStandardTest, LookupWithHiddenSymbols) {
   EXPECT_EQ(Result.count(Bar), 1U) << "Missing result for \"Bar\"";
   EXPECT_EQ(Result[Bar].getAddress(), QuxSym.getAddress())
       << "Wrong result for \"Bar\"";
+
+  // Repeat the lookup now that all symbols are ready. The hidden "Bar" in JD
+  // must still be skipped.
+  Result = cantFail(
+      ES.lookup(JITDylibSearchList({{&JD, false}, {&JD2, false}}), {Foo, Bar}));
+  EXPECT_EQ(Result[Bar].getAddress(), QuxSym.getAddress())
+      << "Wrong result for \"Bar\" once ready";
 }
 
 TEST_F(CoreAPIsStandardTest, LookupFlagsTest) {
@@ -1119,6 +1127,40 @@ TEST_F(CoreAPIsStandardTest, TestLookupWithThreadedMaterialization) {
 #endif
 }
 
+TEST_F(CoreAPIsStandardTest, TestLookupOfRemovedReadySymbol) {
+  cantFail(JD.define(absoluteSymbols({{Foo, FooSym}})));
+  cantFail(ES.lookup(JITDylibSearchList({{&JD, false}}), Foo));
+
+  cantFail(JD.remove({Foo}));
+  EXPECT_THAT_EXPECTED(ES.lookup(JITDylibSearchList({{&JD, false}}), Foo),
+                       Failed<SymbolsNotFound>())
+      << "Lookup of a removed symbol should fail";
+}
+
+TEST_F(CoreAPIsStandardTest, TestConcurrentLookupsOfReadySymbols) {
+#if LLVM_ENABLE_THREADS
+  cantFail(JD.define(absoluteSymbols({{Foo, FooSym}, {Bar, BarSym}})));
+  cantFail(ES.lookup(JITDylibSearchList({{&JD, false}}), {Foo, Bar}));
+
+  std::atomic<unsigned> Mismatches{0};
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I < 8; ++I)
+    Threads.emplace_back([&] {
+      for (unsigned J = 0; J < 1000; ++J) {
+        auto Result = cantFail(
+            ES.lookup(JITDylibSearchList({{&JD, false}}), {Foo, Bar}));
+        if (Result[Foo].getAddress() != FooAddr ||
+            Result[Bar].getAddress() != BarAddr)
+          ++Mismatches;
+      }
+    });
+  for (auto &T : Threads)
+    T.join();
+
+  EXPECT_EQ(Mismatches, 0U) << "Concurrent lookups returned wrong addresses";
+#endif
+}
+
 TEST_F(CoreAPIsStandardTest, TestGetRequestedSymbolsAndReplace) {
   // Test that GetRequestedSymbols returns the set of symbols that currently
   // have pending queries, and test that MaterializationResponsibility's
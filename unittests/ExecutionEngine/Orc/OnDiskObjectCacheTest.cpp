@@ -0,0 +1,139 @@
+//===--- OnDiskObjectCacheTest.cpp - Unit tests for OnDiskObjectCache -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+class OnDiskObjectCacheTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(sys::fs::createUniqueDirectory("OnDiskObjectCacheTest",
+                                                CacheDir));
+  }
+
+  void TearDown() override { sys::fs::remove_directories(CacheDir); }
+
+  std::unique_ptr<Module> createModule(StringRef FunctionName) {
+    auto M = std::make_unique<Module>("M", Ctx);
+    M->getOrInsertFunction(FunctionName, Type::getVoidTy(Ctx));
+    return M;
+  }
+
+  std::unique_ptr<OnDiskObjectCache>
+  createCache(StringRef Triple,
+              CachePruningPolicy Policy = CachePruningPolicy()) {
+    return cantFail(OnDiskObjectCache::Create(
+        CacheDir, JITTargetMachineBuilder(llvm::Triple(Triple)), Policy));
+  }
+
+  SmallString<128> CacheDir;
+  LLVMContext Ctx;
+};
+
+TEST_F(OnDiskObjectCacheTest, ReuseAcrossInstances) {
+  auto M = createModule("foo");
+  {
+    auto Cache = createCache("x86_64-unknown-linux-gnu");
+    EXPECT_EQ(Cache->getObject(M.get()), nullptr) << "Empty cache should miss";
+    Cache->notifyObjectCompiled(M.get(),
+                                MemoryBufferRef("object bytes", "obj"));
+  }
+
+  // A new cache instance over the same directory, e.g. in the next process,
+  // sees the entry.
+  auto Cache = createCache("x86_64-unknown-linux-gnu");
+  auto Obj = Cache->getObject(M.get());
+  ASSERT_NE(Obj, nullptr) << "Object should have been cached";
+  EXPECT_EQ(Obj->getBuffer(), "object bytes");
+}
+
+TEST_F(OnDiskObjectCacheTest, KeyedOnModuleAndTarget) {
+  auto M = createModule("foo");
+  auto Cache = createCache("x86_64-unknown-linux-gnu");
+  EXPECT_EQ(Cache->getObject(M.get()), nullptr);
+  Cache->notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+
+  // A different module must not hit.
+  auto M2 = createModule("bar");
+  EXPECT_EQ(Cache->getObject(M2.get()), nullptr);
+
+  // Neither may the same module compiled for a different target.
+  auto OtherTargetCache = createCache("aarch64-unknown-linux-gnu");
+  EXPECT_EQ(OtherTargetCache->getObject(M.get()), nullptr);
+}
+
+TEST_F(OnDiskObjectCacheTest, KeyComputedBeforeCompilation) {
+  // Code generation may modify the module between the cache miss and the
+  // notification. The entry must be stored under the original key.
+  auto M = createModule("foo");
+  auto Cache = createCache("x86_64-unknown-linux-gnu");
+  EXPECT_EQ(Cache->getObject(M.get()), nullptr);
+  M->getOrInsertFunction("added_by_codegen", Type::getVoidTy(Ctx));
+  Cache->notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+
+  auto Original = createModule("foo");
+  EXPECT_NE(Cache->getObject(Original.get()), nullptr);
+}
+
+TEST_F(OnDiskObjectCacheTest, KeyedOnMCOptions) {
+  auto M = createModule("foo");
+  auto Cache = createCache("x86_64-unknown-linux-gnu");
+  EXPECT_EQ(Cache->getObject(M.get()), nullptr);
+  Cache->notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+
+  JITTargetMachineBuilder JTMB(Triple("x86_64-unknown-linux-gnu"));
+  JTMB.getOptions().MCOptions.MCRelaxAll = true;
+  auto RelaxAllCache = cantFail(OnDiskObjectCache::Create(CacheDir, JTMB));
+  EXPECT_EQ(RelaxAllCache->getObject(M.get()), nullptr);
+}
+
+TEST_F(OnDiskObjectCacheTest, FailedCompilationForgetsKey) {
+  // After a failed compilation the key remembered for the module must be
+  // dropped, or a later module allocated at the same address would be stored
+  // under it.
+  auto M = createModule("foo");
+  auto Cache = createCache("x86_64-unknown-linux-gnu");
+  EXPECT_EQ(Cache->getObject(M.get()), nullptr);
+  Cache->notifyObjectCompileFailed(M.get());
+
+  M->getOrInsertFunction("bar", Type::getVoidTy(Ctx));
+  Cache->notifyObjectCompiled(M.get(), MemoryBufferRef("object bytes", "obj"));
+  EXPECT_EQ(Cache->getObject(createModule("foo").get()), nullptr);
+  EXPECT_NE(Cache->getObject(M.get()), nullptr);
+}
+
+TEST_F(OnDiskObjectCacheTest, PrunesLeftoverTemporaryFiles) {
+  // Simulate a process that was killed while writing an entry two days ago.
+  int FD;
+  SmallString<128> TempPath;
+  ASSERT_FALSE(sys::fs::createUniqueFile(
+      CacheDir + "/llvmcache-OrcJIT-%%%%%%.tmp.o", FD, TempPath));
+  ASSERT_FALSE(sys::fs::setLastAccessAndModificationTime(
+      FD, std::chrono::system_clock::now() - std::chrono::hours(48)));
+  sys::Process::SafelyCloseFileDescriptor(FD);
+
+  CachePruningPolicy Policy;
+  Policy.Expiration = std::chrono::hours(1);
+  createCache("x86_64-unknown-linux-gnu", Policy);
+  EXPECT_FALSE(sys::fs::exists(TempPath));
+}
+
+} // end anonymous namespace
@@ -981,6 +981,26 @@ TEST_F(DILocationTest, cloneTemporary) {
   EXPECT_TRUE(L2->isTemporary());
 }
 
+TEST_F(DILocationTest, reuseStorage) {
+  MDNode *N = MDNode::get(Context, None);
+  DILocation *InlinedAt = DILocation::getDistinct(Context, 1, 1, N);
+  auto L = DILocation::getTemporary(Context, 2, 7, N, InlinedAt);
+  const void *Storage = L.get();
+  L.reset();
+
+  // The storage of a deleted location is reused for one with as many
+  // operands, which get set up again.
+  DILocation *L2 = DILocation::get(Context, 3, 5, N);
+  DILocation *L3 = DILocation::get(Context, 4, 6, N, InlinedAt);
+  EXPECT_NE(Storage, L2);
+  EXPECT_EQ(Storage, L3);
+  EXPECT_EQ(1u, L2->getNumOperands());
+  EXPECT_EQ(2u, L3->getNumOperands());
+  EXPECT_EQ(4u, L3->getLine());
+  EXPECT_EQ(N, L3->getRawScope());
+  EXPECT_EQ(InlinedAt, L3->getInlinedAt());
+}
+
 TEST_F(DILocationTest, discriminatorEncoding) {
   EXPECT_EQ(0U, DILocation::encodeDiscriminator(0, 0, 0).getValue());
 
@@ -14,6 +14,7 @@
 #include "llvm/Support/Parallel.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <atomic>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -49,4 +50,14 @@ TEST(Parallel, parallel_for) {
   ASSERT_EQ(range[2049], 1u);
 }
 
+TEST(Parallel, nested_parallel_for) {
+  // Inner loops run in parallel too; waiting on them must not deadlock even
+  // when every worker is blocked in an outer iteration.
+  std::atomic<uint32_t> Sum{0};
+  for_each_n(parallel::par, 0, 64, [&Sum](size_t I) {
+    for_each_n(parallel::par, 0, 2048, [&Sum](size_t J) { ++Sum; });
+  });
+  ASSERT_EQ(Sum, 64u * 2048u);
+}
+
 #endif
@@ -0,0 +1,145 @@
+//===- llvm/unittest/Support/PerThreadBumpPtrAllocatorTest.cpp ------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include "llvm/Support/StringSaver.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <thread>
+
+using namespace llvm;
+
+namespace {
+
+TEST(PerThreadBumpPtrAllocatorTest, SingleThread) {
+  PerThreadBumpPtrAllocator Arena;
+  EXPECT_EQ(0u, Arena.getNumThreads());
+  EXPECT_EQ(0u, Arena.getTotalMemory());
+
+  BumpPtrAllocator &Alloc = Arena.getThreadLocalAllocator();
+  EXPECT_EQ(&Alloc, &Arena.getThreadLocalAllocator());
+  EXPECT_EQ(1u, Arena.getNumThreads());
+
+  uint64_t *P = Arena.Allocate<uint64_t>(4);
+  P[3] = 42;
+  EXPECT_EQ(32u, Arena.getBytesAllocated());
+  EXPECT_LE(32u, Arena.getTotalMemory());
+
+  // Resetting keeps the slab for the next job.
+  size_t TotalMemory = Arena.getTotalMemory();
+  Arena.Reset();
+  EXPECT_EQ(0u, Arena.getBytesAllocated());
+  EXPECT_EQ(TotalMemory, Arena.getTotalMemory());
+  EXPECT_EQ(&Alloc, &Arena.getThreadLocalAllocator());
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, SeveralArenas) {
+  // Alternating between arenas must not mix up their allocators.
+  auto First = std::make_unique<PerThreadBumpPtrAllocator>();
+  PerThreadBumpPtrAllocator Second;
+  BumpPtrAllocator *FirstAlloc = &First->getThreadLocalAllocator();
+  BumpPtrAllocator *SecondAlloc = &Second.getThreadLocalAllocator();
+  EXPECT_NE(FirstAlloc, SecondAlloc);
+  EXPECT_EQ(FirstAlloc, &First->getThreadLocalAllocator());
+  EXPECT_EQ(SecondAlloc, &Second.getThreadLocalAllocator());
+
+  // More arenas than the thread caches at once still get their own.
+  std::vector<std::unique_ptr<PerThreadBumpPtrAllocator>> Many;
+  std::vector<BumpPtrAllocator *> ManyAllocs;
+  for (unsigned I = 0; I < 20; ++I) {
+    Many.push_back(std::make_unique<PerThreadBumpPtrAllocator>());
+    ManyAllocs.push_back(&Many.back()->getThreadLocalAllocator());
+  }
+  for (unsigned Round = 0; Round < 2; ++Round)
+    for (unsigned I = 0; I < 20; ++I)
+      EXPECT_EQ(ManyAllocs[I], &Many[I]->getThreadLocalAllocator());
+
+  // A new arena never gets the allocator of a destroyed one.
+  First.reset();
+  PerThreadBumpPtrAllocator Third;
+  Third.Allocate(8, 8);
+  EXPECT_EQ(1u, Third.getNumThreads());
+  EXPECT_EQ(8u, Third.getBytesAllocated());
+  EXPECT_EQ(0u, Second.getBytesAllocated());
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(PerThreadBumpPtrAllocatorTest, StringSaverPerThread) {
+  constexpr unsigned NumThreads = 4;
+  constexpr unsigned NumStrings = 1000;
+  PerThreadBumpPtrAllocator Arena;
+  std::vector<std::vector<StringRef>> Saved(NumThreads);
+  std::vector<BumpPtrAllocator *> Allocs(NumThreads);
+
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&, T] {
+      Allocs[T] = &Arena.getThreadLocalAllocator();
+      StringSaver Saver(*Allocs[T]);
+      for (unsigned I = 0; I < NumStrings; ++I)
+        Saved[T].push_back(
+            Saver.save(std::to_string(T) + "-" + std::to_string(I)));
+    });
+  }
+  for (auto &Thread : Threads)
+    Thread.join();
+
+  EXPECT_EQ(NumThreads, Arena.getNumThreads());
+  size_t Bytes = 0;
+  for (unsigned T = 0; T < NumThreads; ++T) {
+    for (unsigned U = 0; U < T; ++U)
+      EXPECT_NE(Allocs[T], Allocs[U]);
+    for (unsigned I = 0; I < NumStrings; ++I) {
+      EXPECT_EQ(std::to_string(T) + "-" + std::to_string(I), Saved[T][I]);
+      Bytes += Saved[T][I].size() + 1;
+    }
+  }
+  EXPECT_EQ(Bytes, Arena.getBytesAllocated());
+}
+
+TEST(PerThreadBumpPtrAllocatorTest, ResetRecyclesAllocators) {
+  // After a reset, new threads take over the allocators and slabs of threads
+  // that have exited instead of creating their own.
+  PerThreadBumpPtrAllocator Arena;
+  BumpPtrAllocator *First = nullptr;
+  std::thread([&] {
+    First = &Arena.getThreadLocalAllocator();
+    First->Allocate(100, 8);
+  }).join();
+  size_t TotalMemory = Arena.getTotalMemory();
+  Arena.Reset();
+
+  BumpPtrAllocator *Second = nullptr;
+  std::thread([&] { Second = &Arena.getThreadLocalAllocator(); }).join();
+  EXPECT_EQ(First, Second);
+  EXPECT_EQ(1u, Arena.getNumThreads());
+  EXPECT_EQ(TotalMemory, Arena.getTotalMemory());
+
+  // Without a reset, each thread needs an allocator of its own.
+  std::thread([&] { Arena.getThreadLocalAllocator(); }).join();
+  EXPECT_EQ(2u, Arena.getNumThreads());
+}
+#endif
+
+struct Counted {
+  static unsigned Live;
+  Counted() { ++Live; }
+  ~Counted() { --Live; }
+};
+unsigned Counted::Live = 0;
+
+TEST(PerThreadBumpPtrAllocatorTest, SpecificAllocator) {
+  PerThreadAllocator<SpecificBumpPtrAllocator<Counted>> Arena;
+  for (unsigned I = 0; I < 10; ++I)
+    new (Arena.getThreadLocalAllocator().Allocate()) Counted();
+  EXPECT_EQ(10u, Counted::Live);
+  Arena.Reset();
+  EXPECT_EQ(0u, Counted::Live);
+}
+
+} // end anonymous namespace
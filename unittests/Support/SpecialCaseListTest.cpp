@@ -243,4 +243,36 @@ TEST_F(SpecialCaseListTest, EscapedSymbols) {
   EXPECT_FALSE(SCL->inSection("", "src", "hello\\\\world"));
 }
 
+TEST_F(SpecialCaseListTest, PrefixAndSuffixWildcards) {
+  std::unique_ptr<SpecialCaseList> SCL = makeSpecialCaseList("fun:foo*\n"
+                                                             "fun:*bar\n"
+                                                             "fun:fo*\n"
+                                                             "fun:f.*z\n"
+                                                             "fun:*\n"
+                                                             "fun:*baz\n"
+                                                             "src:b.*\n"
+                                                             "src:bo*\n"
+                                                             "src:*ob\n"
+                                                             "src:*xo*\n"
+                                                             "global:ab*\n"
+                                                             "global:*bc*\n");
+  // The first entry that matches is blamed, whatever its kind.
+  EXPECT_EQ(1u, SCL->inSectionBlame("", "fun", "foobar"));
+  EXPECT_EQ(1u, SCL->inSectionBlame("", "fun", "foo"));
+  EXPECT_EQ(2u, SCL->inSectionBlame("", "fun", "xbar"));
+  EXPECT_EQ(3u, SCL->inSectionBlame("", "fun", "fox"));
+  EXPECT_EQ(3u, SCL->inSectionBlame("", "fun", "foz"));
+  EXPECT_EQ(4u, SCL->inSectionBlame("", "fun", "fiz"));
+  EXPECT_EQ(5u, SCL->inSectionBlame("", "fun", "xbaz"));
+  EXPECT_EQ(5u, SCL->inSectionBlame("", "fun", ""));
+  EXPECT_EQ(7u, SCL->inSectionBlame("", "src", "bob"));
+  EXPECT_EQ(7u, SCL->inSectionBlame("", "src", "bo"));
+  EXPECT_EQ(9u, SCL->inSectionBlame("", "src", "xob"));
+  EXPECT_EQ(10u, SCL->inSectionBlame("", "src", "xoa"));
+  EXPECT_EQ(0u, SCL->inSectionBlame("", "src", "obx"));
+  // A substring entry loses to an earlier prefix entry.
+  EXPECT_EQ(11u, SCL->inSectionBlame("", "global", "abc"));
+  EXPECT_EQ(12u, SCL->inSectionBlame("", "global", "xbcx"));
+}
+
 }
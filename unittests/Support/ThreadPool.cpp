@@ -146,6 +146,21 @@ TEST_F(ThreadPoolTest, GetFuture) {
   ASSERT_EQ(2, i.load());
 }
 
+TEST_F(ThreadPoolTest, AsyncFromTask) {
+  CHECK_UNSUPPORTED();
+  // Tasks queued by other tasks are accounted for by wait().
+  std::atomic_int checked_in{0};
+  ThreadPool Pool{2};
+  for (size_t i = 0; i < 4; ++i) {
+    Pool.async([&Pool, &checked_in] {
+      for (size_t j = 0; j < 8; ++j)
+        Pool.async([&checked_in] { ++checked_in; });
+    });
+  }
+  Pool.wait();
+  ASSERT_EQ(32, checked_in);
+}
+
 TEST_F(ThreadPoolTest, PoolDestruction) {
   CHECK_UNSUPPORTED();
   // Test that we are waiting on destruction
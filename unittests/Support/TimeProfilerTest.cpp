@@ -0,0 +1,114 @@
+//===- llvm/unittest/Support/TimeProfilerTest.cpp -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/TimeProfiler.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/JSON.h"
+#include "gtest/gtest.h"
+#include <set>
+#include <thread>
+
+using namespace llvm;
+
+namespace {
+
+/// Return the "traceEvents" of the trace written by the calling thread.
+json::Array writeTrace() {
+  SmallString<1024> Buffer;
+  raw_svector_ostream OS(Buffer);
+  timeTraceProfilerWrite(OS);
+  Expected<json::Value> Trace = json::parse(Buffer);
+  EXPECT_TRUE(bool(Trace));
+  if (!Trace) {
+    consumeError(Trace.takeError());
+    return json::Array();
+  }
+  return *Trace->getAsObject()->getArray("traceEvents");
+}
+
+TEST(TimeProfilerTest, SingleThread) {
+  timeTraceProfilerInitialize(0, "test");
+  EXPECT_TRUE(timeTraceProfilerEnabled());
+  {
+    TimeTraceScope Outer("Outer", StringRef("detail"));
+    TimeTraceScope Inner("Inner", [] { return std::string("lazy"); });
+  }
+  json::Array Events = writeTrace();
+  timeTraceProfilerCleanup();
+  EXPECT_FALSE(timeTraceProfilerEnabled());
+
+  unsigned NumScopes = 0;
+  for (const json::Value &V : Events) {
+    const json::Object *E = V.getAsObject();
+    if (E->getString("ph") == StringRef("X") &&
+        E->getString("name")->startswith("Total ")) {
+      EXPECT_NE(0, *E->getInteger("tid"));
+      continue;
+    }
+    if (E->getString("ph") == StringRef("X")) {
+      ++NumScopes;
+      EXPECT_EQ(0, *E->getInteger("tid"));
+      continue;
+    }
+    EXPECT_EQ("process_name", *E->getString("name"));
+    EXPECT_EQ("test", *E->getObject("args")->getString("name"));
+  }
+  EXPECT_EQ(2u, NumScopes);
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(TimeProfilerTest, WorkerThreads) {
+  timeTraceProfilerInitialize(0, "test");
+  {
+    TimeTraceScope Scope("Main", StringRef());
+    std::vector<std::thread> Threads;
+    for (unsigned I = 0; I < 3; ++I) {
+      Threads.emplace_back([I] {
+        EXPECT_FALSE(timeTraceProfilerEnabled());
+        timeTraceProfilerInitialize(0);
+        {
+          TimeTraceScope Scope("Work", StringRef(std::to_string(I)));
+        }
+        timeTraceProfilerFinishThread();
+        EXPECT_FALSE(timeTraceProfilerEnabled());
+      });
+    }
+    for (auto &Thread : Threads)
+      Thread.join();
+  }
+  json::Array Events = writeTrace();
+  timeTraceProfilerCleanup();
+
+  // Every thread gets its own named track next to the main thread's.
+  std::set<int64_t> WorkTracks, NamedTracks;
+  std::set<std::string> Details;
+  for (const json::Value &V : Events) {
+    const json::Object *E = V.getAsObject();
+    StringRef Name = *E->getString("name");
+    int64_t Tid = *E->getInteger("tid");
+    if (Name == "Main") {
+      EXPECT_EQ(0, Tid);
+    }
+    if (Name == "Work") {
+      WorkTracks.insert(Tid);
+      Details.insert(*E->getObject("args")->getString("detail"));
+    }
+    if (Name == "thread_name")
+      NamedTracks.insert(Tid);
+    if (Name == "Total Work") {
+      EXPECT_EQ(3, *E->getObject("args")->getInteger("count"));
+    }
+  }
+  EXPECT_EQ(3u, WorkTracks.size());
+  EXPECT_EQ(0u, WorkTracks.count(0));
+  EXPECT_EQ(WorkTracks, NamedTracks);
+  EXPECT_EQ(3u, Details.size());
+}
+#endif
+
+} // end anonymous namespace
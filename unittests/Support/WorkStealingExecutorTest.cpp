@@ -0,0 +1,80 @@
+//===- llvm/unittest/Support/WorkStealingExecutorTest.cpp -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/WorkStealingExecutor.h"
+#include "gtest/gtest.h"
+
+#if LLVM_ENABLE_THREADS
+
+using namespace llvm;
+
+namespace {
+
+TEST(WorkStealingExecutorTest, RunsAllTasks) {
+  std::atomic<unsigned> Count{0};
+  {
+    WorkStealingExecutor Exec(4);
+    EXPECT_EQ(4u, Exec.getThreadCount());
+    for (unsigned I = 0; I < 1000; ++I)
+      Exec.add([&] { ++Count; });
+    // The destructor drains the queues.
+  }
+  EXPECT_EQ(1000u, Count);
+}
+
+TEST(WorkStealingExecutorTest, TasksSpawnedFromWorkers) {
+  std::atomic<unsigned> Count{0};
+  // Declared before the executor so that it outlives the workers.
+  std::function<void(unsigned)> Spawn;
+  WorkStealingExecutor Exec(3);
+  Spawn = [&](unsigned Depth) {
+    ++Count;
+    if (Depth == 0)
+      return;
+    Exec.add([&, Depth] { Spawn(Depth - 1); });
+    Exec.add([&, Depth] { Spawn(Depth - 1); });
+  };
+  Exec.add([&] { Spawn(9); });
+  Exec.helpUntil([&] { return Count == (1u << 10) - 1; });
+  EXPECT_FALSE(Exec.isWorkerThread());
+  EXPECT_EQ((1u << 10) - 1, Count);
+}
+
+TEST(WorkStealingExecutorTest, NestedWaitDoesNotDeadlock) {
+  // Every task waits for tasks it spawned itself. With a single worker this
+  // only finishes if waiting workers keep executing queued tasks.
+  WorkStealingExecutor Exec(1);
+  std::atomic<unsigned> Outer{0};
+  for (unsigned I = 0; I < 4; ++I) {
+    Exec.add([&] {
+      std::atomic<unsigned> Inner{0};
+      for (unsigned J = 0; J < 4; ++J)
+        Exec.add([&] { ++Inner; });
+      Exec.helpUntil([&] { return Inner == 4; });
+      ++Outer;
+    });
+  }
+  Exec.helpUntil([&] { return Outer == 4; });
+  EXPECT_EQ(4u, Outer);
+}
+
+TEST(WorkStealingExecutorTest, NoWorkers) {
+  // Without workers, the waiting thread has to run everything itself.
+  WorkStealingExecutor Exec(0);
+  unsigned Count = 0;
+  Exec.add([&] { ++Count; });
+  Exec.add([&] { ++Count; });
+  EXPECT_TRUE(Exec.runOneTask());
+  Exec.helpUntil([&] { return Count == 2; });
+  EXPECT_FALSE(Exec.runOneTask());
+  EXPECT_EQ(2u, Count);
+}
+
+} // end anonymous namespace
+
+#endif // LLVM_ENABLE_THREADS
@@ -1681,6 +1681,79 @@ TEST(YAMLIO, TestSequenceDocListWriteAndRead) {
   }
 }
 
+struct NameAndPath {
+  llvm::StringRef name;
+  llvm::StringRef path;
+};
+
+LLVM_YAML_IS_SEQUENCE_VECTOR(NameAndPath)
+
+struct NodeKindsDoc {
+  llvm::StringRef name;
+  std::vector<NameAndPath> entries;
+  std::vector<MyString> flags;
+};
+
+LLVM_YAML_IS_DOCUMENT_LIST_VECTOR(NodeKindsDoc)
+
+namespace llvm {
+namespace yaml {
+  template <>
+  struct MappingTraits<NameAndPath> {
+    static void mapping(IO &io, NameAndPath& np) {
+      io.mapRequired("name", np.name);
+      io.mapRequired("path", np.path);
+    }
+  };
+
+  template <>
+  struct MappingTraits<NodeKindsDoc> {
+    static void mapping(IO &io, NodeKindsDoc& doc) {
+      io.mapRequired("name", doc.name);
+      io.mapOptional("entries", doc.entries);
+      io.mapOptional("flags", doc.flags);
+    }
+  };
+}
+}
+
+//
+// Test a document list whose documents use every kind of node, so that the
+// nodes of each document are allocated where those of the previous one were
+// released, and that scalars copied out of the input outlive their document.
+//
+TEST(YAMLIO, TestDocListReusesNodeStorage) {
+  Input yin("---\nname: first\nentries:\n"
+            "  - name: a\n    path: \"x\\ty\"\n"
+            "  - name: b\n    path: |\n      multi\n      line\n"
+            "flags: [ one, two ]\n"
+            "---\nname: second\nentries:\nflags: [ three ]\n"
+            "---\nname: third\nentries:\n  - name: c\n    path: plain\n");
+  std::vector<NodeKindsDoc> docList;
+  yin >> docList;
+
+  EXPECT_FALSE(yin.error());
+  ASSERT_EQ(docList.size(), 3UL);
+  EXPECT_EQ(docList[0].name, "first");
+  ASSERT_EQ(docList[0].entries.size(), 2UL);
+  EXPECT_EQ(docList[0].entries[0].name, "a");
+  EXPECT_EQ(docList[0].entries[0].path, "x\ty");
+  EXPECT_EQ(docList[0].entries[1].name, "b");
+  EXPECT_EQ(docList[0].entries[1].path, "multi\nline\n");
+  ASSERT_EQ(docList[0].flags.size(), 2UL);
+  EXPECT_EQ(docList[0].flags[0], "one");
+  EXPECT_EQ(docList[0].flags[1], "two");
+  EXPECT_EQ(docList[1].name, "second");
+  EXPECT_TRUE(docList[1].entries.empty());
+  ASSERT_EQ(docList[1].flags.size(), 1UL);
+  EXPECT_EQ(docList[1].flags[0], "three");
+  EXPECT_EQ(docList[2].name, "third");
+  ASSERT_EQ(docList[2].entries.size(), 1UL);
+  EXPECT_EQ(docList[2].entries[0].name, "c");
+  EXPECT_EQ(docList[2].entries[0].path, "plain");
+  EXPECT_TRUE(docList[2].flags.empty());
+}
+
 //===----------------------------------------------------------------------===//
 //  Test document tags
 //===----------------------------------------------------------------------===//
@@ -20,6 +20,7 @@
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/YAMLParser.h"
+#include "llvm/Support/YAMLTraits.h"
 #include "llvm/Support/raw_ostream.h"
 #include <system_error>
 
@@ -142,6 +143,26 @@ static void dumpStream(yaml::Stream &stream) {
   }
 }
 
+namespace {
+struct JSONEntry {
+  StringRef Key1, Key2, Key3;
+};
+} // end anonymous namespace
+
+LLVM_YAML_IS_SEQUENCE_VECTOR(JSONEntry)
+
+namespace llvm {
+namespace yaml {
+template <> struct MappingTraits<JSONEntry> {
+  static void mapping(IO &IO, JSONEntry &E) {
+    IO.mapRequired("key1", E.Key1);
+    IO.mapRequired("key2", E.Key2);
+    IO.mapRequired("key3", E.Key3);
+  }
+};
+} // end namespace yaml
+} // end namespace llvm
+
 static void benchmark(llvm::TimerGroup &Group, llvm::StringRef Name,
                       llvm::StringRef Description, llvm::StringRef JSONText) {
   llvm::Timer BaseLine((Name + ".loop").str(), (Description + ": Loop").str(),
@@ -171,6 +192,16 @@ static void benchmark(llvm::TimerGroup &Group, llvm::StringRef Name,
     stream.skip();
   }
   Parsing.stopTimer();
+
+  llvm::Timer Reading((Name + ".reading").str(),
+                      (Description + ": Reading with yaml::Input").str(), Group);
+  Reading.startTimer();
+  {
+    std::vector<JSONEntry> Entries;
+    llvm::yaml::Input YIn(JSONText);
+    YIn >> Entries;
+  }
+  Reading.stopTimer();
 }
 
 static std::string createJSONText(size_t MemoryMB, unsigned ValueSize) {